@@ -4,262 +4,5569 @@
 #include <string>
 #include <stdexcept>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
 #include <iomanip>
 #include <sstream>
 #include <map>
-#include <regex>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <type_traits>
+#include <string_view>
+#include <chrono>
+#include <filesystem>
+#include <random>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define POLY_SOLVER_X86_SIMD 1
+#else
+#define POLY_SOLVER_X86_SIMD 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define POLY_SOLVER_HAVE_MMAP 1
+#else
+#define POLY_SOLVER_HAVE_MMAP 0
+#endif
+
+/**
+ * Arbitrary-precision signed integer
+ * Sign-magnitude representation over little-endian 64-bit limbs.
+ * Values up to kInlineLimbs limbs (256 bits) live inline in the object, so
+ * typical shares never touch the heap; operands that fit in a single limb
+ * take a direct 128-bit arithmetic fast path.
+ */
+class BigInteger {
+public:
+    using Limb = uint64_t;
+    using DoubleLimb = unsigned __int128;
+    static constexpr size_t kInlineLimbs = 4;
+
+    // Operand sizes (in limbs) from which multiplication switches to Karatsuba,
+    // Toom-3 and the three-prime NTT. The Toom-3 and NTT defaults were measured
+    // on the reference machine by the calibration section of --bench, which only
+    // reports the crossovers; the recursive algorithms need karatsubaThreshold >= 4
+    static inline size_t karatsubaThreshold = 48;
+    static inline size_t toomThreshold = 512;
+    static inline size_t nttThreshold = 2048;
+
+private:
+    /**
+     * Limb storage with a small inline buffer (small-buffer optimization)
+     * Grows onto the heap only when a value exceeds kInlineLimbs limbs.
+     */
+    class LimbBuffer {
+    public:
+        LimbBuffer() : size_(0), capacity_(kInlineLimbs) {}
+
+        LimbBuffer(const LimbBuffer& other) : size_(0), capacity_(kInlineLimbs) {
+            resize(other.size_);
+            std::copy(other.data(), other.data() + other.size_, data());
+        }
+
+        LimbBuffer(LimbBuffer&& other) noexcept : size_(other.size_), capacity_(other.capacity_) {
+            if (other.onHeap()) {
+                heap_ = other.heap_;
+                other.capacity_ = kInlineLimbs;
+            } else {
+                std::copy(other.inline_, other.inline_ + other.size_, inline_);
+            }
+            other.size_ = 0;
+        }
+
+        LimbBuffer& operator=(const LimbBuffer& other) {
+            if (this != &other) {
+                size_ = 0;
+                resize(other.size_);
+                std::copy(other.data(), other.data() + other.size_, data());
+            }
+            return *this;
+        }
+
+        LimbBuffer& operator=(LimbBuffer&& other) noexcept {
+            if (this != &other) {
+                if (onHeap()) delete[] heap_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                if (other.onHeap()) {
+                    heap_ = other.heap_;
+                    other.capacity_ = kInlineLimbs;
+                } else {
+                    std::copy(other.inline_, other.inline_ + other.size_, inline_);
+                }
+                other.size_ = 0;
+            }
+            return *this;
+        }
+
+        ~LimbBuffer() {
+            if (onHeap()) delete[] heap_;
+        }
+
+        Limb* data() { return onHeap() ? heap_ : inline_; }
+        const Limb* data() const { return onHeap() ? heap_ : inline_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        Limb& operator[](size_t i) { return data()[i]; }
+        Limb operator[](size_t i) const { return data()[i]; }
+        Limb back() const { return data()[size_ - 1]; }
+
+        void reserve(size_t n) {
+            if (n <= capacity_) return;
+            size_t newCapacity = std::max(n, static_cast<size_t>(capacity_) * 2);
+            Limb* fresh = new Limb[newCapacity];
+            std::copy(data(), data() + size_, fresh);
+            if (onHeap()) delete[] heap_;
+            heap_ = fresh;
+            capacity_ = static_cast<uint32_t>(newCapacity);
+        }
+
+        // Resizes the buffer; newly exposed limbs are zero-filled
+        void resize(size_t n) {
+            reserve(n);
+            if (n > size_) std::fill(data() + size_, data() + n, Limb(0));
+            size_ = static_cast<uint32_t>(n);
+        }
+
+        void push_back(Limb limb) {
+            reserve(size_ + 1);
+            data()[size_++] = limb;
+        }
+
+        // Drops leading zero limbs so that zero has size 0
+        void normalize() {
+            while (size_ > 0 && data()[size_ - 1] == 0) --size_;
+        }
+
+    private:
+        bool onHeap() const { return capacity_ > kInlineLimbs; }
+
+        uint32_t size_;
+        uint32_t capacity_;
+        union {
+            Limb inline_[kInlineLimbs];
+            Limb* heap_;
+        };
+    };
+
+public:
+    BigInteger() : negative_(false) {}
+
+    BigInteger(long long value) : negative_(value < 0) {
+        // Negate in unsigned space so LLONG_MIN is handled correctly
+        Limb magnitude = negative_ ? Limb(0) - static_cast<Limb>(value) : static_cast<Limb>(value);
+        if (magnitude != 0) mag_.push_back(magnitude);
+    }
+
+    BigInteger(int value) : BigInteger(static_cast<long long>(value)) {}
+
+    BigInteger(unsigned long long value) : negative_(false) {
+        if (value != 0) mag_.push_back(static_cast<Limb>(value));
+    }
+
+    BigInteger(unsigned long value) : BigInteger(static_cast<unsigned long long>(value)) {}
+
+    /**
+     * Builds a value from an unsigned magnitude and a sign
+     */
+    static BigInteger fromUnsigned(Limb magnitude, bool negative = false) {
+        BigInteger result;
+        if (magnitude != 0) {
+            result.mag_.push_back(magnitude);
+            result.negative_ = negative;
+        }
+        return result;
+    }
+
+    /**
+     * Builds a non-negative value from little-endian limbs
+     */
+    static BigInteger fromLimbs(const Limb* limbs, size_t count) {
+        BigInteger result;
+        result.mag_.resize(count);
+        std::copy(limbs, limbs + count, result.mag_.data());
+        result.mag_.normalize();
+        return result;
+    }
+
+    /**
+     * Converts a (rounded) floating-point value to the nearest integer below it
+     */
+    static BigInteger fromLongDouble(long double value) {
+        if (!std::isfinite(value)) {
+            throw std::invalid_argument("Cannot convert non-finite value to integer");
+        }
+        bool negative = value < 0;
+        long double magnitude = std::floor(std::fabs(value));
+        if (magnitude < 18446744073709551616.0L) {
+            return fromUnsigned(static_cast<Limb>(magnitude), negative);
+        }
+        // Split into a 64-bit mantissa and a binary exponent
+        int exponent = 0;
+        long double fraction = std::frexp(magnitude, &exponent);
+        Limb mantissa = static_cast<Limb>(std::ldexp(fraction, 64));
+        BigInteger result = fromUnsigned(mantissa, negative);
+        return result << static_cast<size_t>(exponent - 64);
+    }
+
+    bool isZero() const { return mag_.empty(); }
+    bool isNegative() const { return negative_; }
+    int sign() const { return isZero() ? 0 : (negative_ ? -1 : 1); }
+    size_t limbCount() const { return mag_.size(); }
+
+    /**
+     * True when the value can be represented as a long long
+     */
+    bool fitsInt64() const {
+        if (mag_.size() == 0) return true;
+        if (mag_.size() > 1) return false;
+        Limb limit = negative_ ? (Limb(1) << 63) : (Limb(1) << 63) - 1;
+        return mag_[0] <= limit;
+    }
+
+    long long toInt64() const {
+        if (!fitsInt64()) {
+            throw std::overflow_error("Value does not fit in 64 bits: " + toString());
+        }
+        if (isZero()) return 0;
+        return negative_ ? static_cast<long long>(Limb(0) - mag_[0]) : static_cast<long long>(mag_[0]);
+    }
+
+    // i-th limb of the magnitude (zero past the top limb)
+    Limb limb(size_t i) const { return i < mag_.size() ? mag_[i] : 0; }
+
+    size_t bitLength() const {
+        if (isZero()) return 0;
+        return (mag_.size() - 1) * 64 + (64 - __builtin_clzll(mag_.back()));
+    }
+
+    long double toLongDouble() const {
+        long double result = 0.0L;
+        for (size_t i = mag_.size(); i-- > 0;) {
+            result = result * 18446744073709551616.0L + static_cast<long double>(mag_[i]);
+        }
+        return negative_ ? -result : result;
+    }
+
+    /**
+     * In-place multiply-add by single limbs: *this = *this * multiplier + addend
+     * Used by the base decoder so that each digit costs one pass over the limbs.
+     * Operates on the magnitude; the sign is preserved.
+     */
+    void mulAddSmall(Limb multiplier, Limb addend) {
+        Limb carry = addend;
+        for (size_t i = 0; i < mag_.size(); i++) {
+            DoubleLimb t = static_cast<DoubleLimb>(mag_[i]) * multiplier + carry;
+            mag_[i] = static_cast<Limb>(t);
+            carry = static_cast<Limb>(t >> 64);
+        }
+        if (carry != 0) mag_.push_back(carry);
+        mag_.normalize();
+        if (isZero()) negative_ = false;
+    }
+
+    // Pre-sizes the limb storage for values of up to `limbs` limbs
+    void reserveLimbs(size_t limbs) { mag_.reserve(limbs); }
+
+    /**
+     * Divides the magnitude in place by a single limb and returns the remainder
+     * Runs over the dividend shifted so the divisor's top bit is set, replacing
+     * each 128-by-64 hardware division with a reciprocal multiply (divide2by1).
+     */
+    Limb divModSmall(Limb divisor) {
+        if (divisor == 0) throw std::invalid_argument("Division by zero");
+        const unsigned shift = static_cast<unsigned>(__builtin_clzll(divisor));
+        const Limb d = divisor << shift;
+        const Limb v = reciprocal2by1(d);
+        const size_t n = mag_.size();
+        Limb remainder = shift != 0 && n != 0 ? mag_[n - 1] >> (64 - shift) : 0;
+        for (size_t i = n; i-- > 0;) {
+            Limb low = mag_[i] << shift;
+            if (shift != 0 && i > 0) low |= mag_[i - 1] >> (64 - shift);
+            mag_[i] = divide2by1(remainder, low, d, v, remainder);
+        }
+        mag_.normalize();
+        if (isZero()) negative_ = false;
+        return remainder >> shift;
+    }
+
+    /**
+     * |value| mod a single limb, without modifying the value
+     */
+    Limb modSmall(Limb modulus) const {
+        if (modulus == 0) throw std::invalid_argument("Division by zero");
+        if (mag_.size() <= 1) return mag_.empty() ? 0 : mag_[0] % modulus;
+        const unsigned shift = static_cast<unsigned>(__builtin_clzll(modulus));
+        const Limb d = modulus << shift;
+        const Limb v = reciprocal2by1(d);
+        const size_t n = mag_.size();
+        Limb remainder = shift != 0 ? mag_[n - 1] >> (64 - shift) : 0;
+        for (size_t i = n; i-- > 0;) {
+            Limb low = mag_[i] << shift;
+            if (shift != 0 && i > 0) low |= mag_[i - 1] >> (64 - shift);
+            divide2by1(remainder, low, d, v, remainder);
+        }
+        return remainder >> shift;
+    }
+
+    /**
+     * Digits in any base 2..36 (lowercase letters for digits above 9)
+     * Power-of-two bases read bits straight out of the limbs. Other bases use
+     * divide-and-conquer radix conversion over a cached power tree
+     * base^(chunkDigits * 2^j); large splits use Barrett division with Newton
+     * reciprocals, so long values convert in O(M(n) log n) instead of O(n^2).
+     * Every subtree writes a fixed-width, zero-padded slice of one preallocated
+     * buffer.
+     */
+    std::string toString(int base = 10) const {
+        if (base < 2 || base > 36) {
+            throw std::invalid_argument("Unsupported base: " + std::to_string(base));
+        }
+        if (isZero()) return "0";
+        size_t width;
+        std::string buffer;
+        if ((base & (base - 1)) == 0) {
+            unsigned digitBits = static_cast<unsigned>(__builtin_ctz(static_cast<unsigned>(base)));
+            width = (bitLength() + digitBits - 1) / digitBits;
+            buffer.assign(width + 1, '0');
+            writePowerOfTwoDigits(digitBits, &buffer[1], width);
+        } else {
+            const RadixChunk& chunk = radixChunk(base);
+            BigInteger value = abs();
+            // Smallest level with value < radixPower(base, level + 1); one limb is
+            // always below chunkDivisor^2
+            size_t level = 0;
+            if (value.mag_.size() > 1) {
+                while (compareMagnitude(value.mag_, radixPower(base, level + 1).mag_) >= 0) level++;
+            }
+            width = chunk.digits << (level + 1);
+            buffer.assign(width + 1, '0');
+            writeRadixDigits(std::move(value), base, level, &buffer[1]);
+        }
+        size_t first = buffer.find_first_not_of('0', 1);
+        if (negative_) buffer[--first] = '-';
+        return buffer.substr(first);
+    }
+
+    BigInteger abs() const {
+        BigInteger result = *this;
+        result.negative_ = false;
+        return result;
+    }
+
+    BigInteger operator-() const {
+        BigInteger result = *this;
+        if (!result.isZero()) result.negative_ = !negative_;
+        return result;
+    }
+
+    friend BigInteger operator+(const BigInteger& a, const BigInteger& b) {
+        if (a.mag_.size() <= 1 && b.mag_.size() <= 1) {
+            return fromInt128(a.toSigned128() + b.toSigned128());
+        }
+        return addSigned(a, b, b.negative_);
+    }
+
+    friend BigInteger operator-(const BigInteger& a, const BigInteger& b) {
+        if (a.mag_.size() <= 1 && b.mag_.size() <= 1) {
+            return fromInt128(a.toSigned128() - b.toSigned128());
+        }
+        return addSigned(a, b, !b.negative_);
+    }
+
+    friend BigInteger operator*(const BigInteger& a, const BigInteger& b) {
+        BigInteger result;
+        if (a.isZero() || b.isZero()) return result;
+        result.negative_ = a.negative_ != b.negative_;
+        if (a.mag_.size() == 1 && b.mag_.size() == 1) {
+            DoubleLimb product = static_cast<DoubleLimb>(a.mag_[0]) * b.mag_[0];
+            result.mag_.push_back(static_cast<Limb>(product));
+            result.mag_.push_back(static_cast<Limb>(product >> 64));
+            result.mag_.normalize();
+            return result;
+        }
+        result.mag_.resize(a.mag_.size() + b.mag_.size());
+        multiplyMagnitude(a.mag_.data(), a.mag_.size(), b.mag_.data(), b.mag_.size(), result.mag_.data());
+        result.mag_.normalize();
+        return result;
+    }
+
+    /**
+     * Truncating division (quotient rounds toward zero, remainder takes the
+     * dividend's sign), matching the semantics of the built-in integer types
+     */
+    static void divMod(const BigInteger& dividend, const BigInteger& divisor,
+                       BigInteger& quotient, BigInteger& remainder) {
+        if (divisor.isZero()) {
+            throw std::invalid_argument("Division by zero");
+        }
+        bool quotientNegative = dividend.negative_ != divisor.negative_;
+        bool remainderNegative = dividend.negative_;
+
+        if (compareMagnitude(dividend.mag_, divisor.mag_) < 0) {
+            remainder = dividend;
+            quotient = BigInteger();
+            return;
+        }
+
+        BigInteger q, r;
+        if (divisor.mag_.size() == 1) {
+            q = dividend;
+            Limb rem = q.divModSmall(divisor.mag_[0]);
+            if (rem != 0) r.mag_.push_back(rem);
+        } else {
+            q.mag_.resize(dividend.mag_.size() - divisor.mag_.size() + 1);
+            r.mag_.resize(divisor.mag_.size());
+            divModMagnitude(dividend.mag_.data(), dividend.mag_.size(),
+                            divisor.mag_.data(), divisor.mag_.size(),
+                            q.mag_.data(), r.mag_.data());
+            q.mag_.normalize();
+            r.mag_.normalize();
+        }
+        q.negative_ = !q.isZero() && quotientNegative;
+        r.negative_ = !r.isZero() && remainderNegative;
+        quotient = std::move(q);
+        remainder = std::move(r);
+    }
+
+    friend BigInteger operator/(const BigInteger& a, const BigInteger& b) {
+        BigInteger q, r;
+        divMod(a, b, q, r);
+        return q;
+    }
+
+    friend BigInteger operator%(const BigInteger& a, const BigInteger& b) {
+        BigInteger q, r;
+        divMod(a, b, q, r);
+        return r;
+    }
+
+    friend BigInteger operator<<(const BigInteger& a, size_t bits) {
+        if (a.isZero() || bits == 0) return a;
+        size_t limbShift = bits / 64;
+        unsigned bitShift = static_cast<unsigned>(bits % 64);
+        BigInteger result;
+        result.negative_ = a.negative_;
+        result.mag_.resize(a.mag_.size() + limbShift + 1);
+        for (size_t i = 0; i < a.mag_.size(); i++) {
+            result.mag_[i + limbShift] |= a.mag_[i] << bitShift;
+            if (bitShift != 0) {
+                result.mag_[i + limbShift + 1] = a.mag_[i] >> (64 - bitShift);
+            }
+        }
+        result.mag_.normalize();
+        return result;
+    }
+
+    /**
+     * Shifts the magnitude right (truncates toward zero for negative values)
+     */
+    friend BigInteger operator>>(const BigInteger& a, size_t bits) {
+        size_t limbShift = bits / 64;
+        if (limbShift >= a.mag_.size()) return BigInteger();
+        unsigned bitShift = static_cast<unsigned>(bits % 64);
+        BigInteger result;
+        result.negative_ = a.negative_;
+        result.mag_.resize(a.mag_.size() - limbShift);
+        for (size_t i = 0; i < result.mag_.size(); i++) {
+            Limb limb = a.mag_[i + limbShift] >> bitShift;
+            if (bitShift != 0 && i + limbShift + 1 < a.mag_.size()) {
+                limb |= a.mag_[i + limbShift + 1] << (64 - bitShift);
+            }
+            result.mag_[i] = limb;
+        }
+        result.mag_.normalize();
+        if (result.isZero()) result.negative_ = false;
+        return result;
+    }
+
+    /**
+     * Greatest common divisor of |a| and |b| (Euclid's algorithm); gcd(0, 0) = 0
+     */
+    static BigInteger gcd(BigInteger a, BigInteger b) {
+        a.negative_ = false;
+        b.negative_ = false;
+        while (!b.isZero()) {
+            BigInteger remainder = a % b;
+            a = std::move(b);
+            b = std::move(remainder);
+        }
+        return a;
+    }
+
+    /**
+     * a^-1 mod m via the extended Euclidean algorithm (result in [0, m))
+     */
+    static BigInteger modInverse(const BigInteger& a, const BigInteger& m) {
+        BigInteger r0 = m, r1 = a % m;
+        if (r1.isNegative()) r1 += m;
+        BigInteger t0 = 0, t1 = 1;
+        while (!r1.isZero()) {
+            BigInteger q, r;
+            divMod(r0, r1, q, r);
+            r0 = std::move(r1);
+            r1 = std::move(r);
+            BigInteger t = t0 - q * t1;
+            t0 = std::move(t1);
+            t1 = std::move(t);
+        }
+        if (r0 != BigInteger(1)) {
+            throw std::invalid_argument("Value is not invertible modulo " + m.toString());
+        }
+        if (t0.isNegative()) t0 += m;
+        return t0;
+    }
+
+    BigInteger& operator+=(const BigInteger& other) { return *this = *this + other; }
+    BigInteger& operator-=(const BigInteger& other) { return *this = *this - other; }
+    BigInteger& operator*=(const BigInteger& other) { return *this = *this * other; }
+    BigInteger& operator/=(const BigInteger& other) { return *this = *this / other; }
+    BigInteger& operator%=(const BigInteger& other) { return *this = *this % other; }
+
+    /**
+     * Three-way comparison: negative, zero or positive like strcmp
+     */
+    static int compare(const BigInteger& a, const BigInteger& b) {
+        if (a.negative_ != b.negative_) return a.negative_ ? -1 : 1;
+        int magnitudeOrder = compareMagnitude(a.mag_, b.mag_);
+        return a.negative_ ? -magnitudeOrder : magnitudeOrder;
+    }
+
+    friend bool operator==(const BigInteger& a, const BigInteger& b) { return compare(a, b) == 0; }
+    friend bool operator!=(const BigInteger& a, const BigInteger& b) { return compare(a, b) != 0; }
+    friend bool operator<(const BigInteger& a, const BigInteger& b) { return compare(a, b) < 0; }
+    friend bool operator<=(const BigInteger& a, const BigInteger& b) { return compare(a, b) <= 0; }
+    friend bool operator>(const BigInteger& a, const BigInteger& b) { return compare(a, b) > 0; }
+    friend bool operator>=(const BigInteger& a, const BigInteger& b) { return compare(a, b) >= 0; }
+
+    friend std::ostream& operator<<(std::ostream& out, const BigInteger& value) {
+        return out << value.toString();
+    }
+
+private:
+    using SignedDoubleLimb = __int128;
+
+    // Single-limb values as a signed 128-bit integer (fast path helper)
+    SignedDoubleLimb toSigned128() const {
+        SignedDoubleLimb magnitude = mag_.empty() ? 0 : static_cast<SignedDoubleLimb>(mag_[0]);
+        return negative_ ? -magnitude : magnitude;
+    }
+
+public:
+    static BigInteger fromInt128(__int128 value) {
+        BigInteger result;
+        result.negative_ = value < 0;
+        DoubleLimb magnitude = result.negative_ ? DoubleLimb(0) - static_cast<DoubleLimb>(value)
+                                                : static_cast<DoubleLimb>(value);
+        result.mag_.push_back(static_cast<Limb>(magnitude));
+        result.mag_.push_back(static_cast<Limb>(magnitude >> 64));
+        result.mag_.normalize();
+        if (result.isZero()) result.negative_ = false;
+        return result;
+    }
+
+    static BigInteger fromUnsigned128(unsigned __int128 value) {
+        BigInteger result;
+        result.mag_.push_back(static_cast<Limb>(value));
+        result.mag_.push_back(static_cast<Limb>(value >> 64));
+        result.mag_.normalize();
+        return result;
+    }
+
+    /**
+     * True when the value fits in a signed 128-bit integer
+     */
+    bool fitsInt128() const { return bitLength() <= 127; }
+
+    __int128 toInt128() const {
+        if (!fitsInt128()) {
+            throw std::overflow_error("Value does not fit in 128 bits: " + toString());
+        }
+        __int128 magnitude = static_cast<__int128>((static_cast<DoubleLimb>(limb(1)) << 64) | limb(0));
+        return negative_ ? -magnitude : magnitude;
+    }
+
+private:
+    static int compareMagnitude(const LimbBuffer& a, const LimbBuffer& b) {
+        if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    // a + (bNegative ? -|b| : |b|)
+    static BigInteger addSigned(const BigInteger& a, const BigInteger& b, bool bNegative) {
+        BigInteger result;
+        if (a.negative_ == bNegative) {
+            const LimbBuffer& longer = a.mag_.size() >= b.mag_.size() ? a.mag_ : b.mag_;
+            const LimbBuffer& shorter = a.mag_.size() >= b.mag_.size() ? b.mag_ : a.mag_;
+            result.mag_.resize(longer.size() + 1);
+            Limb carry = addMagnitude(longer.data(), longer.size(), shorter.data(), shorter.size(),
+                                      result.mag_.data());
+            result.mag_[longer.size()] = carry;
+            result.negative_ = bNegative;
+        } else {
+            int order = compareMagnitude(a.mag_, b.mag_);
+            if (order == 0) return result;
+            const LimbBuffer& larger = order > 0 ? a.mag_ : b.mag_;
+            const LimbBuffer& smaller = order > 0 ? b.mag_ : a.mag_;
+            result.mag_.resize(larger.size());
+            subMagnitude(larger.data(), larger.size(), smaller.data(), smaller.size(), result.mag_.data());
+            result.negative_ = order > 0 ? a.negative_ : bNegative;
+        }
+        result.mag_.normalize();
+        return result;
+    }
+
+    // out[0..an) = a + b (an >= bn); returns the carry out of the top limb (out may alias a)
+    static Limb addMagnitude(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out) {
+        Limb carry = 0;
+        for (size_t i = 0; i < an; i++) {
+            DoubleLimb t = static_cast<DoubleLimb>(a[i]) + (i < bn ? b[i] : 0) + carry;
+            out[i] = static_cast<Limb>(t);
+            carry = static_cast<Limb>(t >> 64);
+        }
+        return carry;
+    }
+
+    // out[0..an) = a - b (requires a >= b); returns the final borrow (out may alias a)
+    static Limb subMagnitude(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out) {
+        Limb borrow = 0;
+        for (size_t i = 0; i < an; i++) {
+            Limb subtrahend = i < bn ? b[i] : 0;
+            Limb diff = a[i] - subtrahend - borrow;
+            borrow = (a[i] < subtrahend || (a[i] == subtrahend && borrow)) ? 1 : 0;
+            out[i] = diff;
+        }
+        return borrow;
+    }
+
+    // out[0..an+bn) = a * b (schoolbook); out must be zeroed and not alias inputs
+    static void mulMagnitude(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out) {
+        for (size_t i = 0; i < an; i++) {
+            Limb carry = 0;
+            for (size_t j = 0; j < bn; j++) {
+                DoubleLimb t = static_cast<DoubleLimb>(a[i]) * b[j] + out[i + j] + carry;
+                out[i + j] = static_cast<Limb>(t);
+                carry = static_cast<Limb>(t >> 64);
+            }
+            out[i + bn] = carry;
+        }
+    }
+
+    /**
+     * out[0..an+bn) = a * b, choosing schoolbook, Karatsuba, Toom-3 or the NTT by
+     * the smaller operand's size; out must be zeroed and not alias the inputs.
+     */
+    static void multiplyMagnitude(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out) {
+        if (an < bn) {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        if (bn == 0) return;
+        if (bn < karatsubaThreshold) {
+            mulMagnitude(a, an, b, bn, out);
+            return;
+        }
+        if (bn >= nttThreshold) {
+            nttMultiply(a, an, b, bn, out);
+            return;
+        }
+        if (an >= 2 * bn) {
+            // Unbalanced operands: multiply b by bn-limb slices of a
+            std::vector<Limb> partial(2 * bn);
+            for (size_t offset = 0; offset < an; offset += bn) {
+                size_t length = std::min(bn, an - offset);
+                std::fill(partial.begin(), partial.end(), Limb(0));
+                multiplyMagnitude(a + offset, length, b, bn, partial.data());
+                addInto(out + offset, an + bn - offset, partial.data(), length + bn);
+            }
+            return;
+        }
+        if (bn >= toomThreshold) {
+            toom3(a, an, b, bn, out);
+            return;
+        }
+        karatsuba(a, an, b, bn, out);
+    }
+
+    /**
+     * Karatsuba step for bn <= an < 2 * bn:
+     * a*b = z2 * B^2h + (z1 - z0 - z2) * B^h + z0 with z1 = (a0 + a1)(b0 + b1)
+     */
+    static void karatsuba(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out) {
+        size_t h = (an + 1) / 2;
+        size_t a1n = an - h;
+        size_t b0n = std::min(h, bn);
+        size_t b1n = bn - b0n;
+
+        std::vector<Limb> z0(2 * h, 0), z2(a1n + b1n, 0);
+        multiplyMagnitude(a, h, b, b0n, z0.data());
+        multiplyMagnitude(a + h, a1n, b + h, b1n, z2.data());
+
+        std::vector<Limb> sumA(h + 1, 0), sumB(h + 1, 0);
+        sumA[h] = addMagnitude(a, h, a + h, a1n, sumA.data());
+        sumB[h] = addMagnitude(b, h, b + b0n, b1n, sumB.data());
+        std::vector<Limb> z1(2 * h + 2, 0);
+        multiplyMagnitude(sumA.data(), h + 1, sumB.data(), h + 1, z1.data());
+        subMagnitude(z1.data(), z1.size(), z0.data(), z0.size(), z1.data());
+        subMagnitude(z1.data(), z1.size(), z2.data(), z2.size(), z1.data());
+
+        addInto(out, an + bn, z0.data(), significantLimbs(z0.data(), z0.size()));
+        addInto(out + h, an + bn - h, z1.data(), significantLimbs(z1.data(), z1.size()));
+        addInto(out + 2 * h, an + bn - 2 * h, z2.data(), significantLimbs(z2.data(), z2.size()));
+    }
+
+    /**
+     * Toom-3 step for bn <= an < 2 * bn: both operands are split into three
+     * k-limb pieces, the pieces' polynomials are multiplied at 0, 1, -1, -2 and
+     * infinity, and the product is interpolated with Bodrato's sequence (exact
+     * divisions by 2 and 3 only). Five products of ~n/3 limbs replace nine.
+     */
+    static void toom3(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out) {
+        const size_t k = (an + 2) / 3;
+        auto piece = [k](const Limb* limbs, size_t length, size_t index) {
+            size_t begin = std::min(length, index * k);
+            size_t end = std::min(length, begin + k);
+            return fromLimbs(limbs + begin, end - begin);
+        };
+        BigInteger a0 = piece(a, an, 0), a1 = piece(a, an, 1), a2 = piece(a, an, 2);
+        BigInteger b0 = piece(b, bn, 0), b1 = piece(b, bn, 1), b2 = piece(b, bn, 2);
+
+        BigInteger aEven = a0 + a2, bEven = b0 + b2;
+        BigInteger aOne = aEven + a1, bOne = bEven + b1;
+        BigInteger aMinusOne = aEven - a1, bMinusOne = bEven - b1;
+        BigInteger aMinusTwo = ((aMinusOne + a2) << 1) - a0;
+        BigInteger bMinusTwo = ((bMinusOne + b2) << 1) - b0;
+
+        BigInteger r0 = a0 * b0;
+        BigInteger rInfinity = a2 * b2;
+        BigInteger r1 = aOne * bOne;
+        BigInteger rMinusOne = aMinusOne * bMinusOne;
+        BigInteger r3 = aMinusTwo * bMinusTwo - r1;
+        r3.divModSmall(3);
+        r1 -= rMinusOne;
+        r1.divModSmall(2);
+        BigInteger r2 = rMinusOne - r0;
+        r3 = r2 - r3;
+        r3.divModSmall(2);
+        r3 += rInfinity << 1;
+        r2 += r1 - rInfinity;
+        r1 -= r3;
+
+        // Every coefficient of a product of non-negative pieces is non-negative
+        const BigInteger* coefficients[] = {&r0, &r1, &r2, &r3, &rInfinity};
+        for (size_t i = 0; i < 5; i++) {
+            const LimbBuffer& limbs = coefficients[i]->mag_;
+            if (!limbs.empty()) addInto(out + i * k, an + bn - i * k, limbs.data(), limbs.size());
+        }
+    }
+
+    static void nttMultiply(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out);
+
+    // out[0..outLength) += src[0..srcLength), propagating the carry
+    static void addInto(Limb* out, size_t outLength, const Limb* src, size_t srcLength) {
+        Limb carry = 0;
+        size_t i = 0;
+        for (; i < srcLength; i++) {
+            DoubleLimb t = static_cast<DoubleLimb>(out[i]) + src[i] + carry;
+            out[i] = static_cast<Limb>(t);
+            carry = static_cast<Limb>(t >> 64);
+        }
+        for (; carry != 0 && i < outLength; i++) {
+            carry = ++out[i] == 0 ? 1 : 0;
+        }
+    }
+
+    // v = floor((2^128 - 1) / d) - 2^64 for a normalized d (top bit set)
+    static Limb reciprocal2by1(Limb d) {
+        return static_cast<Limb>(~static_cast<DoubleLimb>(0) / d);
+    }
+
+    /**
+     * Moller-Granlund division of (high:low) by a normalized d with precomputed
+     * v = reciprocal2by1(d); requires high < d. Returns the quotient limb.
+     */
+    static Limb divide2by1(Limb high, Limb low, Limb d, Limb v, Limb& remainder) {
+        DoubleLimb q = static_cast<DoubleLimb>(v) * high + ((static_cast<DoubleLimb>(high) << 64) | low);
+        Limb quotient = static_cast<Limb>(q >> 64) + 1;
+        Limb r = low - quotient * d;
+        if (r > static_cast<Limb>(q)) {
+            quotient--;
+            r += d;
+        }
+        if (r >= d) {
+            quotient++;
+            r -= d;
+        }
+        remainder = r;
+        return quotient;
+    }
+
+    // Largest power of a base that fits in one limb: base^digits
+    struct RadixChunk {
+        Limb divisor;
+        size_t digits;
+    };
+
+    // Values up to this many limbs are converted by repeated single-limb division
+    static constexpr size_t kRadixLeafLimbs = 24;
+    // Powers from this many limbs on are split off with Barrett division
+    static constexpr size_t kBarrettLimbs = 64;
+
+    static const RadixChunk& radixChunk(int base) {
+        static const std::array<RadixChunk, 37> table = [] {
+            std::array<RadixChunk, 37> chunks{};
+            for (Limb b = 2; b <= 36; b++) {
+                RadixChunk chunk{b, 1};
+                while (chunk.divisor <= UINT64_MAX / b) {
+                    chunk.divisor *= b;
+                    chunk.digits++;
+                }
+                chunks[b] = chunk;
+            }
+            return chunks;
+        }();
+        return table[base];
+    }
+
+    /**
+     * Cached power tree: radixPower(base, j) = chunkDivisor^(2^j) (j = 0, 1, 2, ...)
+     * Entries in a deque stay put as the tree grows, so references remain valid.
+     */
+    static const BigInteger& radixPower(int base, size_t level) {
+        static std::map<int, std::deque<BigInteger>> cache;
+        static std::mutex cacheMutex;
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        std::deque<BigInteger>& powers = cache[base];
+        if (powers.empty()) powers.push_back(fromUnsigned(radixChunk(base).divisor));
+        while (powers.size() <= level) powers.push_back(powers.back() * powers.back());
+        return powers[level];
+    }
+
+    // Cached Barrett reciprocals of the power tree entries
+    static const BigInteger& radixReciprocal(int base, size_t level) {
+        static std::map<std::pair<int, size_t>, BigInteger> cache;
+        static std::mutex cacheMutex;
+        const BigInteger& power = radixPower(base, level);
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto found = cache.find({base, level});
+        if (found == cache.end()) found = cache.emplace(std::make_pair(base, level), reciprocal(power)).first;
+        return found->second;
+    }
+
+    // out[0..width) = the low `width` base-b digits of |this|, read bit by bit
+    void writePowerOfTwoDigits(unsigned digitBits, char* out, size_t width) const {
+        static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        const Limb mask = (Limb(1) << digitBits) - 1;
+        for (size_t i = 0; i < width; i++) {
+            size_t bit = i * digitBits;
+            size_t index = bit / 64;
+            unsigned offset = static_cast<unsigned>(bit % 64);
+            Limb digit = mag_[index] >> offset;
+            if (offset + digitBits > 64 && index + 1 < mag_.size()) digit |= mag_[index + 1] << (64 - offset);
+            out[width - 1 - i] = kDigits[digit & mask];
+        }
+    }
+
+    /**
+     * Writes value (0 <= value < radixPower(base, level + 1)) as exactly
+     * chunkDigits * 2^(level + 1) zero-padded digits: the value is split by
+     * radixPower(base, level) and both halves recurse one level down.
+     */
+    static void writeRadixDigits(BigInteger value, int base, size_t level, char* out) {
+        static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        const RadixChunk& chunk = radixChunk(base);
+        const size_t width = chunk.digits << (level + 1);
+        if (level == 0 || value.mag_.size() <= kRadixLeafLimbs) {
+            // Leaf: peel off chunkDigits digits per single-limb division; the
+            // buffer is pre-filled with '0', so leading zeros need no writes.
+            // Digits within a chunk are split off with a multiply-high by
+            // floor((2^64 - 1) / base), which is at most one short of the quotient.
+            const Limb b = static_cast<Limb>(base);
+            const Limb baseReciprocal = UINT64_MAX / b;
+            char* end = out + width;
+            while (!value.isZero()) {
+                Limb digits = value.divModSmall(chunk.divisor);
+                for (size_t i = 0; i < chunk.digits && digits != 0; i++) {
+                    Limb quotient = static_cast<Limb>((static_cast<DoubleLimb>(digits) * baseReciprocal) >> 64);
+                    Limb digit = digits - quotient * b;
+                    Limb correction = digit >= b ? 1 : 0;
+                    end[-1 - static_cast<std::ptrdiff_t>(i)] = kDigits[digit - correction * b];
+                    digits = quotient + correction;
+                }
+                end -= chunk.digits;
+            }
+            return;
+        }
+        const BigInteger& power = radixPower(base, level);
+        BigInteger quotient, remainder;
+        if (power.mag_.size() < kBarrettLimbs) {
+            divMod(value, power, quotient, remainder);
+        } else {
+            barrettDivMod(value, power, radixReciprocal(base, level), quotient, remainder);
+        }
+        value = BigInteger();
+        writeRadixDigits(std::move(quotient), base, level - 1, out);
+        writeRadixDigits(std::move(remainder), base, level - 1, out + width / 2);
+    }
+
+    /**
+     * floor(B^(2n) / d) for an n-limb d > 0 (B = 2^64)
+     * One Newton step x' = x + x * (B^(2n) - d * x) / B^(2n) from the (recursively
+     * computed) reciprocal of d's top half roughly doubles the correct limbs; the
+     * result is then corrected by a few +-1 steps against the exact remainder.
+     */
+    static BigInteger reciprocal(const BigInteger& d) {
+        const size_t n = d.mag_.size();
+        const BigInteger scale = BigInteger(1) << (128 * n);
+        if (n <= 2 * kRadixLeafLimbs) return scale / d;
+        const size_t h = n / 2 + 2;
+        const size_t dropped = 64 * (n - h);
+        BigInteger x = reciprocal(d >> dropped) << dropped;
+        x += (x * (scale - d * x)) >> (128 * n);
+        BigInteger remainder = scale - d * x;
+        for (int corrections = 0; remainder.isNegative() || remainder >= d; corrections++) {
+            if (corrections == 8) return scale / d;  // estimate too far off: exact fallback
+            if (remainder.isNegative()) {
+                x -= 1;
+                remainder += d;
+            } else {
+                x += 1;
+                remainder -= d;
+            }
+        }
+        return x;
+    }
+
+    /**
+     * Barrett division for 0 <= x < B^(2n), with n-limb d and mu = reciprocal(d):
+     * the quotient estimate (x / B^(n-1)) * mu / B^(n+1) is at most 2 too small.
+     */
+    static void barrettDivMod(const BigInteger& x, const BigInteger& d, const BigInteger& mu,
+                              BigInteger& quotient, BigInteger& remainder) {
+        const size_t n = d.mag_.size();
+        quotient = ((x >> (64 * (n - 1))) * mu) >> (64 * (n + 1));
+        remainder = x - quotient * d;
+        while (remainder >= d) {
+            remainder -= d;
+            quotient += 1;
+        }
+    }
+
+    // Length without leading zero limbs
+    static size_t significantLimbs(const Limb* limbs, size_t length) {
+        while (length > 0 && limbs[length - 1] == 0) length--;
+        return length;
+    }
+
+    /**
+     * Knuth's Algorithm D: q[0..un-vn] = u / v, r[0..vn) = u % v
+     * Requires vn >= 2, un >= vn and a non-zero top limb in v.
+     */
+    static void divModMagnitude(const Limb* u, size_t un, const Limb* v, size_t vn, Limb* q, Limb* r) {
+        // Normalize so the divisor's top bit is set
+        unsigned shift = static_cast<unsigned>(__builtin_clzll(v[vn - 1]));
+        std::vector<Limb> vn_(vn), un_(un + 1);
+        for (size_t i = vn - 1; i > 0; i--) {
+            vn_[i] = (v[i] << shift) | (shift ? v[i - 1] >> (64 - shift) : 0);
+        }
+        vn_[0] = v[0] << shift;
+        un_[un] = shift ? u[un - 1] >> (64 - shift) : 0;
+        for (size_t i = un - 1; i > 0; i--) {
+            un_[i] = (u[i] << shift) | (shift ? u[i - 1] >> (64 - shift) : 0);
+        }
+        un_[0] = u[0] << shift;
+
+        const DoubleLimb base = static_cast<DoubleLimb>(1) << 64;
+        for (size_t j = un - vn + 1; j-- > 0;) {
+            // Estimate the quotient digit from the top two limbs
+            DoubleLimb numerator = (static_cast<DoubleLimb>(un_[j + vn]) << 64) | un_[j + vn - 1];
+            DoubleLimb qhat = numerator / vn_[vn - 1];
+            DoubleLimb rhat = numerator % vn_[vn - 1];
+            while (qhat >= base ||
+                   qhat * vn_[vn - 2] > ((rhat << 64) | un_[j + vn - 2])) {
+                qhat--;
+                rhat += vn_[vn - 1];
+                if (rhat >= base) break;
+            }
+
+            // Multiply and subtract qhat * v from the current window
+            Limb borrow = 0;
+            Limb carry = 0;
+            for (size_t i = 0; i < vn; i++) {
+                DoubleLimb product = qhat * vn_[i] + carry;
+                carry = static_cast<Limb>(product >> 64);
+                Limb low = static_cast<Limb>(product);
+                Limb before = un_[i + j];
+                Limb diff = before - low - borrow;
+                borrow = (before < low || (before == low && borrow)) ? 1 : 0;
+                un_[i + j] = diff;
+            }
+            Limb top = un_[j + vn];
+            un_[j + vn] = top - carry - borrow;
+            bool negative = top < carry || (top == carry && borrow);
+
+            // Rare case: the estimate was one too large, add the divisor back
+            if (negative) {
+                qhat--;
+                Limb addCarry = 0;
+                for (size_t i = 0; i < vn; i++) {
+                    DoubleLimb t = static_cast<DoubleLimb>(un_[i + j]) + vn_[i] + addCarry;
+                    un_[i + j] = static_cast<Limb>(t);
+                    addCarry = static_cast<Limb>(t >> 64);
+                }
+                un_[j + vn] += addCarry;
+            }
+            q[j] = static_cast<Limb>(qhat);
+        }
+
+        // Denormalize the remainder
+        for (size_t i = 0; i < vn; i++) {
+            r[i] = (un_[i] >> shift) | (shift && i + 1 <= vn ? (un_[i + 1] << (64 - shift)) : 0);
+        }
+    }
+
+    LimbBuffer mag_;
+    bool negative_;
+};
 
 // Using standard types - no external dependencies required
-using BigInt = long long;
+using BigInt = BigInteger;
 using BigFloat = long double;
 
-/**
- * Simple JSON Parser for our specific use case
- * Parses the JSON structure used in test cases without external dependencies
- */
-class SimpleJsonParser {
-public:
+/**
+ * Prime field GF(p) for odd moduli below 2^64 using Montgomery multiplication
+ * Elements are kept in Montgomery form (a * 2^64 mod p) as plain uint64_t, so
+ * every multiply is one 64x64->128 product plus a REDC step with no division.
+ */
+class MontgomeryField64 {
+public:
+    using Element = uint64_t;
+    using DoubleWord = unsigned __int128;
+
+    explicit MontgomeryField64(uint64_t modulus) : modulus_(modulus) {
+        if (modulus < 3 || (modulus & 1) == 0) {
+            throw std::invalid_argument("Montgomery modulus must be an odd number > 2: " +
+                                        std::to_string(modulus));
+        }
+        // Newton iteration for p^-1 mod 2^64 (each step doubles the correct bits)
+        uint64_t inverse = modulus;
+        for (int i = 0; i < 5; i++) inverse *= 2 - modulus * inverse;
+        modulusInverse_ = inverse;
+        uint64_t r1 = (uint64_t(0) - modulus) % modulus;  // 2^64 mod p
+        r2_ = static_cast<uint64_t>(static_cast<DoubleWord>(r1) * r1 % modulus);
+        one_ = r1;
+    }
+
+    uint64_t modulus() const { return modulus_; }
+    Element zero() const { return 0; }
+    Element one() const { return one_; }
+
+    Element fromUint(uint64_t value) const { return mul(value % modulus_, r2_); }
+
+    Element fromBigInt(const BigInt& value) const {
+        if (value.limbCount() <= 1) {
+            uint64_t residue = value.modSmall(modulus_);
+            if (value.isNegative() && residue != 0) residue = modulus_ - residue;
+            return fromUint(residue);
+        }
+        // Horner over limbs in Montgomery form: acc = acc * 2^64 + limb, two REDCs per limb
+        Element result = 0;
+        for (size_t i = value.limbCount(); i-- > 0;) {
+            result = add(mul(result, r2_), mul(value.limb(i), r2_));
+        }
+        return value.isNegative() ? neg(result) : result;
+    }
+
+    uint64_t toUint(Element a) const { return reduce(a); }
+    BigInt toBigInt(Element a) const { return BigInt::fromUnsigned(toUint(a)); }
+
+    // add/sub/reduce select with masks rather than branches: the conditions are
+    // data-dependent coin flips inside NTT butterflies
+    Element add(Element a, Element b) const {
+        uint64_t sum = a + b;
+        uint64_t wrap = 0 - static_cast<uint64_t>((sum < a) | (sum >= modulus_));
+        return sum - (modulus_ & wrap);
+    }
+
+    Element sub(Element a, Element b) const {
+        return a - b + (modulus_ & (0 - static_cast<uint64_t>(a < b)));
+    }
+
+    Element neg(Element a) const { return a == 0 ? 0 : modulus_ - a; }
+
+    Element mul(Element a, Element b) const {
+        return reduce(static_cast<DoubleWord>(a) * b);
+    }
+
+    Element pow(Element base, uint64_t exponent) const {
+        Element result = one_;
+        while (exponent != 0) {
+            if (exponent & 1) result = mul(result, base);
+            base = mul(base, base);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    // Inverse by Fermat's little theorem (requires a prime modulus)
+    Element inv(Element a) const {
+        if (a == 0) throw std::invalid_argument("Inverse of zero in GF(p)");
+        return pow(a, modulus_ - 2);
+    }
+
+private:
+    // REDC: returns t * 2^-64 mod p for t < p * 2^64 (valid for any odd p < 2^64)
+    Element reduce(DoubleWord t) const {
+        uint64_t low = static_cast<uint64_t>(t);
+        uint64_t high = static_cast<uint64_t>(t >> 64);
+        uint64_t m = low * modulusInverse_;
+        uint64_t mp = static_cast<uint64_t>((static_cast<DoubleWord>(m) * modulus_) >> 64);
+        return high - mp + (modulus_ & (0 - static_cast<uint64_t>(high < mp)));
+    }
+
+    uint64_t modulus_;
+    uint64_t modulusInverse_;  // p^-1 mod 2^64
+    uint64_t r2_;              // 2^128 mod p, converts into Montgomery form
+    uint64_t one_;             // 2^64 mod p
+};
+
+/**
+ * Prime field GF(p) for odd multi-limb moduli below 2^(64*Limbs)
+ * Elements are fixed-size limb arrays in Montgomery form; multiplication uses
+ * the CIOS (coarsely integrated operand scanning) method. MontgomeryFieldN<4>
+ * covers 256-bit fields.
+ */
+template <size_t Limbs>
+class MontgomeryFieldN {
+public:
+    using Limb = uint64_t;
+    using DoubleWord = unsigned __int128;
+    using Element = std::array<Limb, Limbs>;
+
+    explicit MontgomeryFieldN(const BigInt& modulus) {
+        if (modulus.sign() <= 0 || modulus.limb(0) % 2 == 0 || modulus.bitLength() > 64 * Limbs ||
+            modulus < BigInt(3)) {
+            throw std::invalid_argument("Unsupported Montgomery modulus: " + modulus.toString());
+        }
+        modulusBig_ = modulus;
+        for (size_t i = 0; i < Limbs; i++) modulus_[i] = modulus.limb(i);
+        uint64_t inverse = modulus_[0];
+        for (int i = 0; i < 5; i++) inverse *= 2 - modulus_[0] * inverse;
+        n0_ = uint64_t(0) - inverse;  // -p^-1 mod 2^64
+        r2_ = toLimbs((BigInt(1) << (128 * Limbs)) % modulus);
+        one_ = toLimbs((BigInt(1) << (64 * Limbs)) % modulus);
+    }
+
+    const BigInt& modulus() const { return modulusBig_; }
+    Element zero() const { return Element{}; }
+    Element one() const { return one_; }
+
+    Element fromUint(uint64_t value) const { return fromBigInt(BigInt::fromUnsigned(value)); }
+
+    Element fromBigInt(const BigInt& value) const {
+        BigInt residue = value % modulusBig_;
+        if (residue.isNegative()) residue += modulusBig_;
+        return mul(toLimbs(residue), r2_);
+    }
+
+    BigInt toBigInt(Element a) const {
+        Element plain{};
+        plain[0] = 1;
+        Element value = mul(a, plain);
+        return BigInt::fromLimbs(value.data(), Limbs);
+    }
+
+    Element add(const Element& a, const Element& b) const {
+        Element sum;
+        Limb carry = 0;
+        for (size_t i = 0; i < Limbs; i++) {
+            DoubleWord t = static_cast<DoubleWord>(a[i]) + b[i] + carry;
+            sum[i] = static_cast<Limb>(t);
+            carry = static_cast<Limb>(t >> 64);
+        }
+        if (carry || !lessThanModulus(sum)) subtractModulus(sum);
+        return sum;
+    }
+
+    Element sub(const Element& a, const Element& b) const {
+        Element diff;
+        Limb borrow = 0;
+        for (size_t i = 0; i < Limbs; i++) {
+            DoubleWord t = static_cast<DoubleWord>(a[i]) - b[i] - borrow;
+            diff[i] = static_cast<Limb>(t);
+            borrow = static_cast<Limb>(t >> 64) ? 1 : 0;
+        }
+        if (borrow) {
+            Limb carry = 0;
+            for (size_t i = 0; i < Limbs; i++) {
+                DoubleWord t = static_cast<DoubleWord>(diff[i]) + modulus_[i] + carry;
+                diff[i] = static_cast<Limb>(t);
+                carry = static_cast<Limb>(t >> 64);
+            }
+        }
+        return diff;
+    }
+
+    Element neg(const Element& a) const { return sub(Element{}, a); }
+
+    Element mul(const Element& a, const Element& b) const {
+        Limb t[Limbs + 2] = {};
+        for (size_t i = 0; i < Limbs; i++) {
+            // t += a * b[i]
+            Limb carry = 0;
+            for (size_t j = 0; j < Limbs; j++) {
+                DoubleWord s = static_cast<DoubleWord>(a[j]) * b[i] + t[j] + carry;
+                t[j] = static_cast<Limb>(s);
+                carry = static_cast<Limb>(s >> 64);
+            }
+            DoubleWord s = static_cast<DoubleWord>(t[Limbs]) + carry;
+            t[Limbs] = static_cast<Limb>(s);
+            t[Limbs + 1] = static_cast<Limb>(s >> 64);
+
+            // t = (t + m * p) / 2^64 with m chosen to clear the low limb
+            Limb m = t[0] * n0_;
+            s = static_cast<DoubleWord>(m) * modulus_[0] + t[0];
+            carry = static_cast<Limb>(s >> 64);
+            for (size_t j = 1; j < Limbs; j++) {
+                s = static_cast<DoubleWord>(m) * modulus_[j] + t[j] + carry;
+                t[j - 1] = static_cast<Limb>(s);
+                carry = static_cast<Limb>(s >> 64);
+            }
+            s = static_cast<DoubleWord>(t[Limbs]) + carry;
+            t[Limbs - 1] = static_cast<Limb>(s);
+            t[Limbs] = t[Limbs + 1] + static_cast<Limb>(s >> 64);
+        }
+        Element result;
+        std::copy(t, t + Limbs, result.begin());
+        if (t[Limbs] != 0 || !lessThanModulus(result)) subtractModulus(result);
+        return result;
+    }
+
+    Element pow(Element base, const BigInt& exponent) const {
+        Element result = one_;
+        for (size_t bit = exponent.bitLength(); bit-- > 0;) {
+            result = mul(result, result);
+            if ((exponent.limb(bit / 64) >> (bit % 64)) & 1) result = mul(result, base);
+        }
+        return result;
+    }
+
+    // Inverse by Fermat's little theorem (requires a prime modulus)
+    Element inv(const Element& a) const {
+        if (a == Element{}) throw std::invalid_argument("Inverse of zero in GF(p)");
+        return pow(a, modulusBig_ - BigInt(2));
+    }
+
+private:
+    static Element toLimbs(const BigInt& value) {
+        Element limbs{};
+        for (size_t i = 0; i < Limbs; i++) limbs[i] = value.limb(i);
+        return limbs;
+    }
+
+    bool lessThanModulus(const Element& a) const {
+        for (size_t i = Limbs; i-- > 0;) {
+            if (a[i] != modulus_[i]) return a[i] < modulus_[i];
+        }
+        return false;
+    }
+
+    void subtractModulus(Element& a) const {
+        Limb borrow = 0;
+        for (size_t i = 0; i < Limbs; i++) {
+            DoubleWord t = static_cast<DoubleWord>(a[i]) - modulus_[i] - borrow;
+            a[i] = static_cast<Limb>(t);
+            borrow = static_cast<Limb>(t >> 64) ? 1 : 0;
+        }
+    }
+
+    BigInt modulusBig_;
+    Element modulus_{};
+    Limb n0_ = 0;     // -p^-1 mod 2^64
+    Element r2_{};    // 2^(128*Limbs) mod p
+    Element one_{};   // 2^(64*Limbs) mod p
+};
+
+/**
+ * Inverts every element in place with a single field inversion (Montgomery's trick)
+ * Prefix products are inverted once and unwound backwards, so n inverses cost
+ * 1 inversion + 3(n-1) multiplications. Throws if any element is zero.
+ */
+template <typename Field>
+void batchInvert(const Field& field, std::vector<typename Field::Element>& values) {
+    using Element = typename Field::Element;
+    if (values.empty()) return;
+    std::vector<Element> prefix(values.size());
+    Element running = field.one();
+    for (size_t i = 0; i < values.size(); i++) {
+        if (values[i] == field.zero()) {
+            throw std::invalid_argument("Batch inversion of zero in GF(p)");
+        }
+        prefix[i] = running;
+        running = field.mul(running, values[i]);
+    }
+    Element inverse = field.inv(running);
+    for (size_t i = values.size(); i-- > 0;) {
+        Element original = values[i];
+        values[i] = field.mul(inverse, prefix[i]);
+        inverse = field.mul(inverse, original);
+    }
+}
+
+/**
+ * Polynomial arithmetic over a Montgomery prime field (coefficients low to high)
+ * Multiplication is schoolbook for small operands, a radix-2 NTT once operands
+ * are large and the word-sized prime is NTT-friendly (p = c * 2^e + 1 with
+ * 2^e >= product length, e.g. 4179340454199820289 = 29 * 2^57 + 1) and
+ * Karatsuba otherwise (multi-limb fields, or word primes without enough roots
+ * of unity). Division uses Newton iteration for the reversed-divisor inverse,
+ * so it costs O(M(n)).
+ */
+template <typename Field>
+class PolynomialRing {
+public:
+    using Element = typename Field::Element;
+    using Poly = std::vector<Element>;
+
+    // Below this operand size schoolbook multiplication beats the NTT
+    static constexpr size_t kNttCutoff = 64;
+    // Below this operand size schoolbook multiplication beats Karatsuba
+    static constexpr size_t kKaratsubaCutoff = 32;
+
+    explicit PolynomialRing(const Field& field) : field_(field) {
+        if constexpr (std::is_same_v<Field, MontgomeryField64>) {
+            uint64_t order = field.modulus() - 1;
+            twoAdicity_ = static_cast<unsigned>(__builtin_ctzll(order));
+            // A quadratic non-residue generates the full 2-Sylow subgroup
+            Element generator = field.zero();
+            for (uint64_t candidate = 2; candidate < 1000; candidate++) {
+                Element g = field.fromUint(candidate);
+                if (field.pow(g, order / 2) != field.one()) {
+                    generator = g;
+                    break;
+                }
+            }
+            if (generator == field.zero()) {
+                twoAdicity_ = 0;
+                return;
+            }
+            roots_.assign(twoAdicity_ + 1, field.one());
+            inverseRoots_.assign(twoAdicity_ + 1, field.one());
+            roots_[twoAdicity_] = field.pow(generator, order >> twoAdicity_);
+            for (unsigned level = twoAdicity_; level > 0; level--) {
+                roots_[level - 1] = field.mul(roots_[level], roots_[level]);
+            }
+            for (unsigned level = 0; level <= twoAdicity_; level++) {
+                inverseRoots_[level] = field.inv(roots_[level]);
+            }
+        }
+    }
+
+    const Field& field() const { return field_; }
+
+    /**
+     * True when products of total length `length` can use the NTT
+     */
+    bool supportsNtt(size_t length) const {
+        size_t size = 1;
+        unsigned log = 0;
+        while (size < length) {
+            size <<= 1;
+            log++;
+        }
+        return log <= twoAdicity_ && log < 63;
+    }
+
+    Poly multiply(const Poly& a, const Poly& b) const {
+        if (a.empty() || b.empty()) return Poly();
+        size_t resultSize = a.size() + b.size() - 1;
+        if (std::min(a.size(), b.size()) <= kKaratsubaCutoff) {
+            Poly result(resultSize, field_.zero());
+            schoolbook(a.data(), a.size(), b.data(), b.size(), result.data());
+            return result;
+        }
+        if constexpr (std::is_same_v<Field, MontgomeryField64>) {
+            if (std::min(a.size(), b.size()) <= kNttCutoff) {
+                Poly result(resultSize, field_.zero());
+                schoolbook(a.data(), a.size(), b.data(), b.size(), result.data());
+                return result;
+            }
+            if (supportsNtt(resultSize)) {
+                size_t size = 1;
+                while (size < resultSize) size <<= 1;
+                Poly fa(a), fb(b);
+                fa.resize(size, field_.zero());
+                fb.resize(size, field_.zero());
+                transform(fa, false);
+                transform(fb, false);
+                for (size_t i = 0; i < size; i++) fa[i] = field_.mul(fa[i], fb[i]);
+                transform(fa, true);
+                fa.resize(resultSize);
+                return fa;
+            }
+        }
+        // Karatsuba on balanced blocks: the longer operand is cut into pieces the
+        // length of the shorter one
+        const Poly& longer = a.size() >= b.size() ? a : b;
+        const Poly& shorter = a.size() >= b.size() ? b : a;
+        size_t blockSize = shorter.size();
+        Poly result(resultSize, field_.zero());
+        Poly block(blockSize), product(2 * blockSize - 1);
+        for (size_t offset = 0; offset < longer.size(); offset += blockSize) {
+            size_t length = std::min(blockSize, longer.size() - offset);
+            std::copy(longer.begin() + offset, longer.begin() + offset + length, block.begin());
+            std::fill(block.begin() + length, block.end(), field_.zero());
+            karatsuba(block.data(), shorter.data(), blockSize, product.data());
+            size_t usable = std::min(product.size(), resultSize - offset);
+            for (size_t j = 0; j < usable; j++) result[offset + j] = field_.add(result[offset + j], product[j]);
+        }
+        return result;
+    }
+
+    /**
+     * Power series inverse: a^-1 mod x^n (requires a[0] != 0)
+     */
+    Poly inverseSeries(const Poly& a, size_t n) const {
+        Poly result{field_.inv(a[0])};
+        const Element two = field_.add(field_.one(), field_.one());
+        size_t precision = 1;
+        while (precision < n) {
+            precision = std::min(precision * 2, n);
+            // result = result * (2 - a * result) mod x^precision
+            Poly truncated(a.begin(), a.begin() + std::min(a.size(), precision));
+            Poly correction = multiply(truncated, result);
+            correction.resize(precision, field_.zero());
+            for (Element& c : correction) c = field_.neg(c);
+            correction[0] = field_.add(correction[0], two);
+            result = multiply(result, correction);
+            result.resize(precision, field_.zero());
+        }
+        return result;
+    }
+
+    /**
+     * a = quotient * b + remainder with deg remainder < deg b (b must have a
+     * non-zero leading coefficient; the remainder keeps b.size() - 1 slots)
+     */
+    void divide(const Poly& a, const Poly& b, Poly& quotient, Poly& remainder) const {
+        if (a.size() < b.size()) {
+            quotient.clear();
+            remainder = a;
+            return;
+        }
+        size_t quotientSize = a.size() - b.size() + 1;
+        if (b.size() <= kNttCutoff || quotientSize <= kNttCutoff) {
+            // Schoolbook long division
+            Poly work(a);
+            quotient.assign(quotientSize, field_.zero());
+            Element leadInverse = field_.inv(b.back());
+            for (size_t i = quotientSize; i-- > 0;) {
+                Element factor = field_.mul(work[i + b.size() - 1], leadInverse);
+                quotient[i] = factor;
+                if (factor == field_.zero()) continue;
+                for (size_t j = 0; j < b.size(); j++) {
+                    work[i + j] = field_.sub(work[i + j], field_.mul(factor, b[j]));
+                }
+            }
+            work.resize(b.size() - 1);
+            remainder = std::move(work);
+            return;
+        }
+        // rev(q) = rev(a) * rev(b)^-1 mod x^quotientSize
+        Poly reversedA(a.rbegin(), a.rbegin() + quotientSize);
+        Poly reversedB(b.rbegin(), b.rend());
+        quotient = multiply(reversedA, inverseSeries(reversedB, quotientSize));
+        quotient.resize(quotientSize);
+        std::reverse(quotient.begin(), quotient.end());
+        Poly product = multiply(quotient, b);
+        remainder.resize(b.size() - 1);
+        for (size_t i = 0; i < remainder.size(); i++) remainder[i] = field_.sub(a[i], product[i]);
+    }
+
+    /**
+     * a mod b (b must have a non-zero leading coefficient)
+     */
+    Poly remainder(const Poly& a, const Poly& b) const {
+        if (a.size() < b.size()) return a;
+        Poly quotient, result;
+        divide(a, b, quotient, result);
+        return result;
+    }
+
+    Poly derivative(const Poly& a) const {
+        if (a.size() <= 1) return Poly();
+        Poly result(a.size() - 1);
+        Element factor = field_.one();
+        for (size_t i = 1; i < a.size(); i++) {
+            result[i - 1] = field_.mul(a[i], factor);
+            factor = field_.add(factor, field_.one());
+        }
+        return result;
+    }
+
+    Element evaluate(const Poly& a, Element x) const {
+        Element result = field_.zero();
+        for (size_t i = a.size(); i-- > 0;) result = field_.add(field_.mul(result, x), a[i]);
+        return result;
+    }
+
+private:
+    // out[0, an + bn - 1) += a * b
+    void schoolbook(const Element* a, size_t an, const Element* b, size_t bn, Element* out) const {
+        for (size_t i = 0; i < an; i++) {
+            for (size_t j = 0; j < bn; j++) out[i + j] = field_.add(out[i + j], field_.mul(a[i], b[j]));
+        }
+    }
+
+    // out[0, 2n - 1) = a * b for two length-n operands
+    void karatsuba(const Element* a, const Element* b, size_t n, Element* out) const {
+        std::fill(out, out + 2 * n - 1, field_.zero());
+        if (n <= kKaratsubaCutoff) {
+            schoolbook(a, n, b, n, out);
+            return;
+        }
+        // a = a0 + x^low * a1 with |a0| = low <= |a1| = high
+        size_t low = n / 2, high = n - low;
+        Poly sumA(a + low, a + n), sumB(b + low, b + n);
+        for (size_t i = 0; i < low; i++) {
+            sumA[i] = field_.add(sumA[i], a[i]);
+            sumB[i] = field_.add(sumB[i], b[i]);
+        }
+        Poly z0(2 * low - 1), z1(2 * high - 1), z2(2 * high - 1);
+        karatsuba(a, b, low, z0.data());
+        karatsuba(a + low, b + low, high, z2.data());
+        karatsuba(sumA.data(), sumB.data(), high, z1.data());
+        for (size_t i = 0; i < z0.size(); i++) z1[i] = field_.sub(z1[i], z0[i]);
+        for (size_t i = 0; i < z2.size(); i++) z1[i] = field_.sub(z1[i], z2[i]);
+        for (size_t i = 0; i < z0.size(); i++) out[i] = z0[i];
+        for (size_t i = 0; i < z2.size(); i++) out[2 * low + i] = field_.add(out[2 * low + i], z2[i]);
+        for (size_t i = 0; i < z1.size(); i++) out[low + i] = field_.add(out[low + i], z1[i]);
+    }
+
+    // In-place iterative Cooley-Tukey NTT (size must be a power of two)
+    void transform(Poly& a, bool inverse) const {
+        size_t n = a.size();
+        for (size_t i = 1, j = 0; i < n; i++) {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(a[i], a[j]);
+        }
+        // Local copy: stores into `a` could otherwise alias the field's constants,
+        // forcing them to be reloaded in every butterfly
+        const Field field = field_;
+        Poly twiddles(n / 2);
+        unsigned level = 0;
+        for (size_t length = 2; length <= n; length <<= 1) {
+            level++;
+            Element step = inverse ? inverseRoots_[level] : roots_[level];
+            size_t half = length / 2;
+            twiddles[0] = field.one();
+            for (size_t j = 1; j < half; j++) twiddles[j] = field.mul(twiddles[j - 1], step);
+            for (size_t i = 0; i < n; i += length) {
+                Element* low = a.data() + i;
+                Element* high = low + half;
+                for (size_t j = 0; j < half; j++) {
+                    Element u = low[j];
+                    Element v = field.mul(high[j], twiddles[j]);
+                    low[j] = field.add(u, v);
+                    high[j] = field.sub(u, v);
+                }
+            }
+        }
+        if (inverse) {
+            Element scale = field_.inv(field_.fromUint(n));
+            for (Element& c : a) c = field_.mul(c, scale);
+        }
+    }
+
+    const Field& field_;
+    unsigned twoAdicity_ = 0;
+    std::vector<Element> roots_;         // roots_[m] has order 2^m
+    std::vector<Element> inverseRoots_;
+};
+
+using FieldPolynomials = PolynomialRing<MontgomeryField64>;
+
+/**
+ * Subproduct tree over points x_0..x_{k-1}: leaves are (x - x_i), every inner
+ * node is the product of its children and the root is M(x) = Π (x - x_i).
+ * Supports multipoint evaluation (remainder tree) and fast interpolation,
+ * both in O(M(k) log k) field operations.
+ */
+template <typename Field>
+class SubproductTree {
+public:
+    using Element = typename Field::Element;
+    using Poly = std::vector<Element>;
+
+    // Nodes at or below this degree are evaluated directly with Horner's rule
+    static constexpr size_t kDirectEvaluationDegree = 32;
+
+    SubproductTree(const PolynomialRing<Field>& polys, const std::vector<Element>& points)
+        : polys_(polys), points_(points) {
+        const Field& field = polys.field();
+        std::vector<Poly> level;
+        for (const Element& x : points) level.push_back(Poly{field.neg(x), field.one()});
+        levels_.push_back(level);
+        while (levels_.back().size() > 1) {
+            const std::vector<Poly>& below = levels_.back();
+            std::vector<Poly> above;
+            for (size_t i = 0; i + 1 < below.size(); i += 2) {
+                above.push_back(polys.multiply(below[i], below[i + 1]));
+            }
+            if (below.size() % 2 == 1) above.push_back(below.back());
+            levels_.push_back(std::move(above));
+        }
+    }
+
+    const Poly& root() const { return levels_.back()[0]; }
+
+    /**
+     * Evaluates f at every point (deg f < number of points)
+     */
+    std::vector<Element> evaluate(const Poly& f) const {
+        std::vector<Element> values(points_.size());
+        evaluateNode(levels_.size() - 1, 0, polys_.remainder(f, root()), values);
+        return values;
+    }
+
+    /**
+     * Full interpolating polynomial: Σ w_i * M(x) / (x - x_i) with w_i = y_i / M'(x_i)
+     */
+    Poly interpolate(const std::vector<Element>& ys) const {
+        const Field& field = polys_.field();
+        std::vector<Element> weights = evaluate(polys_.derivative(root()));
+        batchInvert(field, weights);
+        std::vector<Poly> current;
+        for (size_t i = 0; i < ys.size(); i++) current.push_back(Poly{field.mul(ys[i], weights[i])});
+        for (size_t level = 0; level + 1 < levels_.size(); level++) {
+            const std::vector<Poly>& nodes = levels_[level];
+            std::vector<Poly> combined;
+            for (size_t i = 0; i + 1 < nodes.size(); i += 2) {
+                Poly left = polys_.multiply(current[i], nodes[i + 1]);
+                Poly right = polys_.multiply(current[i + 1], nodes[i]);
+                if (left.size() < right.size()) left.resize(right.size(), field.zero());
+                for (size_t j = 0; j < right.size(); j++) left[j] = field.add(left[j], right[j]);
+                combined.push_back(std::move(left));
+            }
+            if (nodes.size() % 2 == 1) combined.push_back(current.back());
+            current = std::move(combined);
+        }
+        return current[0];
+    }
+
+private:
+    // Index range [first, first + count) of points covered by a node
+    size_t nodeFirstPoint(size_t level, size_t index) const { return index << level; }
+
+    void evaluateNode(size_t level, size_t index, const Poly& remainder, std::vector<Element>& values) const {
+        const Poly& node = levels_[level][index];
+        size_t first = nodeFirstPoint(level, index);
+        size_t count = node.size() - 1;
+        if (count <= kDirectEvaluationDegree || level == 0) {
+            for (size_t i = first; i < first + count; i++) values[i] = polys_.evaluate(remainder, points_[i]);
+            return;
+        }
+        const std::vector<Poly>& children = levels_[level - 1];
+        size_t left = 2 * index;
+        if (left + 1 >= children.size()) {
+            // Odd node carried up unchanged from the level below
+            evaluateNode(level - 1, left, remainder, values);
+            return;
+        }
+        evaluateNode(level - 1, left, polys_.remainder(remainder, children[left]), values);
+        evaluateNode(level - 1, left + 1, polys_.remainder(remainder, children[left + 1]), values);
+    }
+
+    const PolynomialRing<Field>& polys_;
+    std::vector<Element> points_;
+    std::vector<std::vector<Poly>> levels_;  // levels_[0] = leaves, levels_.back() = root
+};
+
+/**
+ * Reed-Solomon decoding of shares over GF(p)
+ * n shares y_i = f(x_i) of a polynomial with deg f < k form a codeword, so f
+ * survives up to e = floor((n - k) / 2) wrong shares. Berlekamp-Welch solves
+ * one linear system in 2e + k unknowns (O(n^3), simplest for small n); Gao's
+ * decoder interpolates all n shares and runs a partial extended Euclid against
+ * Π (x - x_i), which the half-GCD brings down to O(M(n) log n).
+ */
+template <typename Field>
+class ReedSolomonDecoder {
+public:
+    using Element = typename Field::Element;
+    using Poly = std::vector<Element>;
+
+    // Up to this many shares decode() solves the Berlekamp-Welch system; --bench
+    // reports the crossover with Gao (between 12 and 16 shares at k = n/4 with
+    // the full error budget on the reference machine)
+    static constexpr size_t kBerlekampWelchMaxShares = 15;
+    // Below this degree the extended Euclid proceeds one division at a time
+    static constexpr size_t kHalfGcdThreshold = 64;
+
+    explicit ReedSolomonDecoder(const PolynomialRing<Field>& polys) : polys_(polys), field_(polys.field()) {}
+
+    /**
+     * Most wrong shares that n shares of a polynomial with deg < k can absorb
+     */
+    static size_t capacity(size_t n, size_t k) { return n >= k ? (n - k) / 2 : 0; }
+
+    /**
+     * Recovers f (deg f < k) from shares at distinct xs, choosing Berlekamp-Welch
+     * or Gao by share count, and lists the positions where y_i != f(x_i).
+     * Returns false when more than capacity(n, k) shares are wrong.
+     */
+    bool decode(const std::vector<Element>& xs, const std::vector<Element>& ys, size_t k, Poly& message,
+                std::vector<size_t>& errors) const {
+        std::vector<Element> values(xs.size());
+        if (xs.size() <= kBerlekampWelchMaxShares) {
+            if (!berlekampWelch(xs, ys, k, message)) return false;
+            for (size_t i = 0; i < xs.size(); i++) values[i] = polys_.evaluate(message, xs[i]);
+        } else {
+            SubproductTree<Field> tree(polys_, xs);
+            if (!gao(tree, ys, k, message)) return false;
+            values = tree.evaluate(message);
+        }
+        errors.clear();
+        for (size_t i = 0; i < xs.size(); i++) {
+            if (values[i] != ys[i]) errors.push_back(i);
+        }
+        return true;
+    }
+
+    /**
+     * Berlekamp-Welch: finds a monic error locator E of degree e and Q of degree
+     * < e + k with Q(x_i) = y_i * E(x_i) for every share, then f = Q / E
+     */
+    bool berlekampWelch(const std::vector<Element>& xs, const std::vector<Element>& ys, size_t k,
+                        Poly& message) const {
+        const size_t n = xs.size();
+        const size_t e = capacity(n, k);
+        const size_t unknowns = 2 * e + k;
+        // Row i: [1 x .. x^(e+k-1) | -y -yx .. -yx^(e-1) | yx^e]
+        std::vector<Poly> rows(n, Poly(unknowns + 1, field_.zero()));
+        for (size_t i = 0; i < n; i++) {
+            Poly& row = rows[i];
+            Element power = field_.one();
+            for (size_t j = 0; j < e + k; j++) {
+                row[j] = power;
+                if (j < e) row[e + k + j] = field_.neg(field_.mul(ys[i], power));
+                if (j == e) row[unknowns] = field_.mul(ys[i], power);
+                power = field_.mul(power, xs[i]);
+            }
+        }
+
+        // Gauss-Jordan elimination; free unknowns stay zero (any solution gives the same Q / E)
+        std::vector<size_t> pivotColumns;
+        size_t rank = 0;
+        for (size_t column = 0; column < unknowns && rank < n; column++) {
+            size_t pivot = rank;
+            while (pivot < n && rows[pivot][column] == field_.zero()) pivot++;
+            if (pivot == n) continue;
+            std::swap(rows[rank], rows[pivot]);
+            Element inverse = field_.inv(rows[rank][column]);
+            for (size_t j = column; j <= unknowns; j++) rows[rank][j] = field_.mul(rows[rank][j], inverse);
+            for (size_t i = 0; i < n; i++) {
+                if (i == rank || rows[i][column] == field_.zero()) continue;
+                Element factor = rows[i][column];
+                for (size_t j = column; j <= unknowns; j++) {
+                    rows[i][j] = field_.sub(rows[i][j], field_.mul(factor, rows[rank][j]));
+                }
+            }
+            pivotColumns.push_back(column);
+            rank++;
+        }
+        for (size_t i = rank; i < n; i++) {
+            if (rows[i][unknowns] != field_.zero()) return false;  // inconsistent: too many errors
+        }
+        Poly solution(unknowns, field_.zero());
+        for (size_t i = 0; i < rank; i++) solution[pivotColumns[i]] = rows[i][unknowns];
+
+        Poly numerator(solution.begin(), solution.begin() + e + k);
+        Poly locator(solution.begin() + e + k, solution.end());
+        locator.push_back(field_.one());
+        return divideExactly(numerator, locator, k, message);
+    }
+
+    /**
+     * Gao: with g0 = Π (x - x_i) and g1 interpolating every share, the extended
+     * Euclid on (g0, g1) stopped at the first remainder g of degree < (n + k) / 2
+     * has cofactor v (g ≡ v * g1 mod g0) dividing g exactly, and f = g / v
+     */
+    bool gao(const std::vector<Element>& xs, const std::vector<Element>& ys, size_t k, Poly& message) const {
+        return gao(SubproductTree<Field>(polys_, xs), ys, k, message);
+    }
+
+    bool gao(const SubproductTree<Field>& tree, const std::vector<Element>& ys, size_t k, Poly& message) const {
+        Poly interpolant = tree.interpolate(ys);
+        trim(interpolant);
+        const size_t bound = (tree.root().size() - 1 + k + 1) / 2;  // ceil((n + k) / 2)
+        Poly remainder, cofactor;
+        partialEuclid(tree.root(), interpolant, bound, remainder, cofactor);
+        return divideExactly(remainder, cofactor, k, message);
+    }
+
+    /**
+     * Extended Euclid on (a, b) with deg a > deg b, stopped at the first remainder
+     * of degree < bound; returns it with its cofactor v (remainder ≡ v * b mod a)
+     */
+    void partialEuclid(const Poly& a, const Poly& b, size_t bound, Poly& remainder, Poly& cofactor) const {
+        Poly current(a), next(b);
+        Matrix m = identity();
+        if (degree(next) >= static_cast<long>(bound) && a.size() > kHalfGcdThreshold) {
+            // Quotients down to degree `bound` depend only on the top 2 * (deg a - bound)
+            // coefficients, and the half-GCD of those stops exactly there
+            size_t shift = 2 * bound > a.size() - 1 ? 2 * bound - (a.size() - 1) : 0;
+            m = halfGcd(shifted(a, shift), shifted(b, shift));
+            apply(m, current, next);
+        }
+        while (degree(next) >= static_cast<long>(bound)) step(m, current, next);
+        remainder = std::move(next);
+        cofactor = std::move(m.bottomRight);
+    }
+
+private:
+    // 2x2 polynomial matrix acting on the column (a, b)
+    struct Matrix {
+        Poly topLeft, topRight, bottomLeft, bottomRight;
+    };
+
+    static long degree(const Poly& a) { return static_cast<long>(a.size()) - 1; }
+
+    static Poly shifted(const Poly& a, size_t shift) {
+        return shift >= a.size() ? Poly() : Poly(a.begin() + shift, a.end());
+    }
+
+    void trim(Poly& a) const {
+        while (!a.empty() && a.back() == field_.zero()) a.pop_back();
+    }
+
+    Poly combine(const Poly& a, const Poly& b, bool subtract) const {
+        Poly result(std::max(a.size(), b.size()), field_.zero());
+        for (size_t i = 0; i < a.size(); i++) result[i] = a[i];
+        for (size_t i = 0; i < b.size(); i++) {
+            result[i] = subtract ? field_.sub(result[i], b[i]) : field_.add(result[i], b[i]);
+        }
+        trim(result);
+        return result;
+    }
+
+    Matrix identity() const { return Matrix{Poly{field_.one()}, Poly(), Poly(), Poly{field_.one()}}; }
+
+    Matrix product(const Matrix& x, const Matrix& y) const {
+        auto dot = [&](const Poly& a, const Poly& b, const Poly& c, const Poly& d) {
+            return combine(polys_.multiply(a, b), polys_.multiply(c, d), false);
+        };
+        return Matrix{dot(x.topLeft, y.topLeft, x.topRight, y.bottomLeft),
+                      dot(x.topLeft, y.topRight, x.topRight, y.bottomRight),
+                      dot(x.bottomLeft, y.topLeft, x.bottomRight, y.bottomLeft),
+                      dot(x.bottomLeft, y.topRight, x.bottomRight, y.bottomRight)};
+    }
+
+    void apply(const Matrix& m, Poly& a, Poly& b) const {
+        Poly top = combine(polys_.multiply(m.topLeft, a), polys_.multiply(m.topRight, b), false);
+        b = combine(polys_.multiply(m.bottomLeft, a), polys_.multiply(m.bottomRight, b), false);
+        a = std::move(top);
+    }
+
+    // One Euclidean step (a, b) -> (b, a mod b), folded into m
+    void step(Matrix& m, Poly& a, Poly& b) const {
+        Poly quotient, rest;
+        polys_.divide(a, b, quotient, rest);
+        trim(rest);
+        a = std::move(b);
+        b = std::move(rest);
+        Poly left = combine(m.topLeft, polys_.multiply(quotient, m.bottomLeft), true);
+        Poly right = combine(m.topRight, polys_.multiply(quotient, m.bottomRight), true);
+        m.topLeft = std::move(m.bottomLeft);
+        m.topRight = std::move(m.bottomRight);
+        m.bottomLeft = std::move(left);
+        m.bottomRight = std::move(right);
+    }
+
+    /**
+     * Half-GCD: the matrix taking (a, b), deg a > deg b, to the consecutive
+     * remainders whose degrees straddle ceil(deg a / 2). The top half of the
+     * coefficients decides the first quotients, so two recursive calls on
+     * quarter-size inputs and one explicit division cover the whole range.
+     */
+    Matrix halfGcd(Poly a, Poly b) const {
+        const long half = (degree(a) + 1) / 2;
+        Matrix m = identity();
+        if (degree(b) < half) return m;
+        if (a.size() <= kHalfGcdThreshold) {
+            while (degree(b) >= half) step(m, a, b);
+            return m;
+        }
+        m = halfGcd(shifted(a, static_cast<size_t>(half)), shifted(b, static_cast<size_t>(half)));
+        apply(m, a, b);
+        if (degree(b) < half) return m;
+        step(m, a, b);
+        const size_t shift = static_cast<size_t>(2 * half - degree(a));
+        return product(halfGcd(shifted(a, shift), shifted(b, shift)), m);
+    }
+
+    // f = numerator / denominator when the division is exact and deg f < k
+    bool divideExactly(Poly numerator, Poly denominator, size_t k, Poly& message) const {
+        trim(numerator);
+        trim(denominator);
+        if (denominator.empty()) return false;
+        Poly quotient, rest;
+        polys_.divide(numerator, denominator, quotient, rest);
+        trim(rest);
+        trim(quotient);
+        if (!rest.empty() || quotient.size() > k) return false;
+        message = std::move(quotient);
+        return true;
+    }
+
+    const PolynomialRing<Field>& polys_;
+    const Field& field_;
+};
+
+/**
+ * Moduli and reconstruction for multi-modular (CRT) arithmetic
+ * The moduli are 62-bit primes of the form c * 2^32 + 1, so every residue
+ * field is also NTT-friendly for the subproduct-tree engine.
+ */
+class CrtToolkit {
+public:
+    /**
+     * Deterministic Miller-Rabin for 64-bit odd n > 2 (these bases cover all n < 2^64)
+     */
+    static bool isPrime64(uint64_t n) {
+        if (n < 2) return false;
+        for (uint64_t small : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+            if (n % small == 0) return n == small;
+        }
+        MontgomeryField64 field(n);
+        uint64_t d = n - 1;
+        int twos = 0;
+        while ((d & 1) == 0) {
+            d >>= 1;
+            twos++;
+        }
+        const MontgomeryField64::Element minusOne = field.neg(field.one());
+        for (uint64_t base : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+            MontgomeryField64::Element x = field.pow(field.fromUint(base), d);
+            if (x == field.one() || x == minusOne) continue;
+            bool composite = true;
+            for (int i = 1; i < twos && composite; i++) {
+                x = field.mul(x, x);
+                if (x == minusOne) composite = false;
+            }
+            if (composite) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Primality of the GF(p) moduli (up to 512 bits): deterministic Miller-Rabin
+     * below 2^64, Baillie-PSW above (a strong probable-prime test to base 2 and a
+     * strong Lucas test with Selfridge's parameters; no composite is known to pass
+     * both, while fixed Miller-Rabin bases have known strong pseudoprimes)
+     */
+    static bool isPrime(const BigInt& n) {
+        if (n.sign() <= 0) return false;
+        size_t bits = n.bitLength();
+        if (bits <= 64) return isPrime64(n.limb(0));
+        for (uint64_t small : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+            if (n.modSmall(small) == 0) return false;
+        }
+        if (isSquare(n)) return false;  // Selfridge's search for D would not end
+        if (bits <= 128) return bailliePsw(MontgomeryFieldN<2>(n), n);
+        if (bits <= 256) return bailliePsw(MontgomeryFieldN<4>(n), n);
+        if (bits <= 512) return bailliePsw(MontgomeryFieldN<8>(n), n);
+        throw std::invalid_argument("Prime too large for GF(p) interpolation (max 512 bits): " + n.toString());
+    }
+
+    /**
+     * The first `count` primes c * 2^32 + 1 below 2^62, in descending order (cached)
+     */
+    static std::vector<uint64_t> primes(size_t count) {
+        static std::vector<uint64_t> cache;
+        static std::mutex cacheMutex;
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        uint64_t c = cache.empty() ? (uint64_t(1) << 30) - 1 : (cache.back() >> 32) - 2;
+        while (cache.size() < count) {
+            if (c == 0) throw std::runtime_error("Ran out of 62-bit CRT primes");
+            uint64_t candidate = (c << 32) + 1;
+            if (isPrime64(candidate)) cache.push_back(candidate);
+            c -= 2;
+        }
+        return std::vector<uint64_t>(cache.begin(), cache.begin() + count);
+    }
+
+    /**
+     * Balanced CRT tree: returns the unique x with |x| < M/2 and x ≡ residues[i] (mod moduli[i])
+     * Pairs of congruences are merged level by level, so the big multiplications
+     * happen on operands of similar size.
+     */
+    static BigInt reconstructSymmetric(const std::vector<uint64_t>& residues, const std::vector<uint64_t>& moduli) {
+        if (residues.empty()) return BigInt();
+        std::vector<std::pair<BigInt, BigInt>> level;  // (residue, modulus)
+        for (size_t i = 0; i < residues.size(); i++) {
+            level.emplace_back(BigInt(residues[i]), BigInt(moduli[i]));
+        }
+        while (level.size() > 1) {
+            std::vector<std::pair<BigInt, BigInt>> above;
+            for (size_t i = 0; i + 1 < level.size(); i += 2) {
+                const BigInt& r1 = level[i].first;
+                const BigInt& m1 = level[i].second;
+                const BigInt& r2 = level[i + 1].first;
+                const BigInt& m2 = level[i + 1].second;
+                // x = r1 + m1 * ((r2 - r1) * m1^-1 mod m2)
+                BigInt difference = (r2 - r1) % m2;
+                if (difference.isNegative()) difference += m2;
+                BigInt lift = difference * BigInt::modInverse(m1, m2) % m2;
+                above.emplace_back(r1 + m1 * lift, m1 * m2);
+            }
+            if (level.size() % 2 == 1) above.push_back(std::move(level.back()));
+            level = std::move(above);
+        }
+        BigInt value = level[0].first;
+        if (value * BigInt(2) > level[0].second) value -= level[0].second;
+        return value;
+    }
+
+private:
+    template <typename Field>
+    static bool bailliePsw(const Field& field, const BigInt& n) {
+        return strongProbablePrime(field, n, 2) && strongLucasProbablePrime(field, n);
+    }
+
+    // Strong probable-prime test of odd n > 37 to `base`, in n's Montgomery field
+    template <typename Field>
+    static bool strongProbablePrime(const Field& field, const BigInt& n, uint64_t base) {
+        BigInt d = n - BigInt(1);
+        int twos = 0;
+        while ((d.limb(0) & 1) == 0) {
+            d = d >> 1;
+            twos++;
+        }
+        const typename Field::Element minusOne = field.neg(field.one());
+        typename Field::Element x = field.pow(field.fromUint(base), d);
+        if (x == field.one() || x == minusOne) return true;
+        for (int i = 1; i < twos; i++) {
+            x = field.mul(x, x);
+            if (x == minusOne) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Strong Lucas probable-prime test of odd, non-square n > 37: P = 1 and
+     * Q = (1 - D) / 4 for the first D in 5, -7, 9, -11, ... with (D/n) = -1.
+     * With n + 1 = d * 2^s, n passes when U_d = 0 or V_(d*2^r) = 0 for some r < s.
+     * Halving multiplies by (n + 1) / 2, which needs no inverse in a ring.
+     */
+    template <typename Field>
+    static bool strongLucasProbablePrime(const Field& field, const BigInt& n) {
+        using Element = typename Field::Element;
+        int64_t discriminant = 5;
+        for (int symbol; (symbol = jacobi(discriminant, n)) != -1;) {
+            if (symbol == 0) return false;  // |D| < n shares a factor with n
+            discriminant = discriminant > 0 ? -(discriminant + 2) : 2 - discriminant;
+        }
+        auto fromSigned = [&](int64_t value) {
+            Element magnitude = field.fromUint(static_cast<uint64_t>(value < 0 ? -value : value));
+            return value < 0 ? field.neg(magnitude) : magnitude;
+        };
+        const Element d = fromSigned(discriminant);
+        const Element q = fromSigned((1 - discriminant) / 4);
+        const Element half = field.fromBigInt((n + BigInt(1)) >> 1);
+        
+        BigInt k = n + BigInt(1);
+        int twos = 0;
+        while ((k.limb(0) & 1) == 0) {
+            k = k >> 1;
+            twos++;
+        }
+        // U_1 = 1, V_1 = P = 1; doubling and the +1 step climb the bits of k
+        Element u = field.one(), v = field.one(), qk = q;
+        for (size_t bit = k.bitLength() - 1; bit-- > 0;) {
+            u = field.mul(u, v);
+            v = field.sub(field.mul(v, v), field.add(qk, qk));
+            qk = field.mul(qk, qk);
+            if ((k.limb(bit / 64) >> (bit % 64)) & 1) {
+                Element nextU = field.mul(field.add(u, v), half);
+                v = field.mul(field.add(field.mul(d, u), v), half);
+                u = nextU;
+                qk = field.mul(qk, q);
+            }
+        }
+        if (u == field.zero() || v == field.zero()) return true;
+        for (int r = 1; r < twos; r++) {
+            v = field.sub(field.mul(v, v), field.add(qk, qk));
+            if (v == field.zero()) return true;
+            qk = field.mul(qk, qk);
+        }
+        return false;
+    }
+
+    // Jacobi symbol (a/n) for odd n > 2^64 and small a
+    static int jacobi(int64_t a, const BigInt& n) {
+        int result = 1;
+        uint64_t nMod8 = n.limb(0) & 7;
+        if (a < 0) {
+            a = -a;
+            if ((nMod8 & 3) == 3) result = -result;  // (-1/n)
+        }
+        uint64_t top = static_cast<uint64_t>(a);
+        while (top != 0 && (top & 1) == 0) {
+            top >>= 1;
+            if (nMod8 == 3 || nMod8 == 5) result = -result;  // (2/n)
+        }
+        if (top == 0) return 0;
+        if ((top & 3) == 3 && (nMod8 & 3) == 3) result = -result;  // reciprocity
+        uint64_t bottom = top;
+        top = n.modSmall(bottom);
+        // (top/bottom) with word-sized operands
+        while (top != 0) {
+            while ((top & 1) == 0) {
+                top >>= 1;
+                if ((bottom & 7) == 3 || (bottom & 7) == 5) result = -result;
+            }
+            std::swap(top, bottom);
+            if ((top & 3) == 3 && (bottom & 3) == 3) result = -result;
+            top %= bottom;
+        }
+        return bottom == 1 ? result : 0;
+    }
+
+    // Newton's integer square root, squared back
+    static bool isSquare(const BigInt& n) {
+        BigInt root = BigInt(1) << (n.bitLength() / 2 + 1);
+        while (true) {
+            BigInt next = (root + n / root) >> 1;
+            if (next >= root) break;
+            root = next;
+        }
+        return root * root == n;
+    }
+};
+
+/**
+ * Three-prime NTT multiplication for BigInteger (defined here because it needs
+ * the field and polynomial classes). Limbs are used directly as coefficients,
+ * convolved modulo three 62-bit primes c * 2^32 + 1 and recombined per position
+ * with Garner's CRT; this is exact while min(an, bn) * 2^128 stays below the
+ * primes' ~2^186 product.
+ */
+inline void BigInteger::nttMultiply(const Limb* a, size_t an, const Limb* b, size_t bn, Limb* out) {
+    static const std::vector<uint64_t> primes = CrtToolkit::primes(3);
+    static const MontgomeryField64 fields[3] = {
+        MontgomeryField64(primes[0]), MontgomeryField64(primes[1]), MontgomeryField64(primes[2])};
+    static const FieldPolynomials engines[3] = {
+        FieldPolynomials(fields[0]), FieldPolynomials(fields[1]), FieldPolynomials(fields[2])};
+
+    if (!engines[0].supportsNtt(an + bn)) {
+        toom3(a, an, b, bn, out);
+        return;
+    }
+    std::vector<FieldPolynomials::Poly> residues(3);
+    for (size_t j = 0; j < 3; j++) {
+        FieldPolynomials::Poly pa(an), pb(bn);
+        for (size_t i = 0; i < an; i++) pa[i] = fields[j].fromUint(a[i]);
+        for (size_t i = 0; i < bn; i++) pb[i] = fields[j].fromUint(b[i]);
+        residues[j] = engines[j].multiply(pa, pb);
+    }
+
+    // Garner: x = r0 + p0 * t1 + p0 * p1 * t2 with t1, t2 reduced mod p1, p2
+    const MontgomeryField64& f1 = fields[1];
+    const MontgomeryField64& f2 = fields[2];
+    const MontgomeryField64::Element p0InverseMod1 = f1.inv(f1.fromUint(primes[0]));
+    const MontgomeryField64::Element p0Mod2 = f2.fromUint(primes[0]);
+    const MontgomeryField64::Element p01InverseMod2 = f2.inv(f2.mul(p0Mod2, f2.fromUint(primes[1])));
+    const DoubleLimb p01 = static_cast<DoubleLimb>(primes[0]) * primes[1];
+    const Limb p01Low = static_cast<Limb>(p01), p01High = static_cast<Limb>(p01 >> 64);
+
+    const size_t outLength = an + bn;
+    for (size_t i = 0; i + 1 < outLength; i++) {
+        uint64_t r0 = fields[0].toUint(residues[0][i]);
+        MontgomeryField64::Element r0Mod1 = f1.fromUint(r0), r0Mod2 = f2.fromUint(r0);
+        uint64_t t1 = f1.toUint(f1.mul(f1.sub(residues[1][i], r0Mod1), p0InverseMod1));
+        MontgomeryField64::Element xMod2 = f2.add(f2.mul(p0Mod2, f2.fromUint(t1)), r0Mod2);
+        uint64_t t2 = f2.toUint(f2.mul(f2.sub(residues[2][i], xMod2), p01InverseMod2));
+
+        // value = x + p01 * t2 as three limbs
+        DoubleLimb x = static_cast<DoubleLimb>(primes[0]) * t1 + r0;
+        DoubleLimb low = static_cast<DoubleLimb>(p01Low) * t2;
+        DoubleLimb high = static_cast<DoubleLimb>(p01High) * t2;
+        DoubleLimb limb0 = static_cast<DoubleLimb>(static_cast<Limb>(low)) + static_cast<Limb>(x);
+        DoubleLimb limb1 = (low >> 64) + static_cast<Limb>(high) + static_cast<Limb>(x >> 64) + (limb0 >> 64);
+        Limb value[3] = {static_cast<Limb>(limb0), static_cast<Limb>(limb1),
+                         static_cast<Limb>(high >> 64) + static_cast<Limb>(limb1 >> 64)};
+        addInto(out + i, outLength - i, value, significantLimbs(value, std::min<size_t>(3, outLength - i)));
+    }
+}
+
+/**
+ * Cached Lagrange weights Li(0) for the consecutive x-coordinates 1..k
+ * For xi = i the weights reduce to signed binomials, Li(0) = (-1)^(i-1) * C(k, i),
+ * so interpolation becomes a single dot product with the y-vector. Tables are
+ * built once per k (and per modulus in GF(p)) and shared across calls/threads.
+ */
+class ConsecutiveWeights {
+public:
+    /**
+     * Exact integer weights for x = 1..k
+     */
+    static const std::vector<BigInt>& exact(int k) {
+        static std::map<int, std::vector<BigInt>> cache;
+        static std::mutex cacheMutex;
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto found = cache.find(k);
+        if (found != cache.end()) return found->second;
+
+        std::vector<BigInt> weights;
+        BigInt binomial = 1;  // C(k, i), updated as C(k, i) = C(k, i-1) * (k-i+1) / i
+        for (int i = 1; i <= k; i++) {
+            binomial.mulAddSmall(static_cast<BigInt::Limb>(k - i + 1), 0);
+            binomial.divModSmall(static_cast<BigInt::Limb>(i));
+            weights.push_back(i % 2 == 1 ? binomial : -binomial);
+        }
+        return cache.emplace(k, std::move(weights)).first->second;
+    }
+
+    /**
+     * GF(p) weights for x = 1..k (requires p > k so that 1..k stay distinct)
+     * Binomials come from factorials with a single field inversion.
+     */
+    template <typename Field>
+    static const std::vector<typename Field::Element>& modular(const Field& field, int k) {
+        using Element = typename Field::Element;
+        using Key = std::pair<std::decay_t<decltype(field.modulus())>, int>;
+        static std::map<Key, std::vector<Element>> cache;
+        static std::mutex cacheMutex;
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        Key key(field.modulus(), k);
+        auto found = cache.find(key);
+        if (found != cache.end()) return found->second;
+
+        std::vector<Element> factorials(k + 1, field.one());
+        for (int i = 1; i <= k; i++) {
+            factorials[i] = field.mul(factorials[i - 1], field.fromUint(static_cast<uint64_t>(i)));
+        }
+        std::vector<Element> inverseFactorials(k + 1);
+        inverseFactorials[k] = field.inv(factorials[k]);
+        for (int i = k; i > 0; i--) {
+            inverseFactorials[i - 1] = field.mul(inverseFactorials[i], field.fromUint(static_cast<uint64_t>(i)));
+        }
+        std::vector<Element> weights;
+        for (int i = 1; i <= k; i++) {
+            Element binomial = field.mul(factorials[k], field.mul(inverseFactorials[i], inverseFactorials[k - i]));
+            weights.push_back(i % 2 == 1 ? binomial : field.neg(binomial));
+        }
+        return cache.emplace(key, std::move(weights)).first->second;
+    }
+
+    /**
+     * True when the first numPoints x-coordinates are exactly 1, 2, ..., numPoints
+     */
+    template <typename Point>
+    static bool isConsecutiveFromOne(const std::vector<Point>& points, int numPoints) {
+        for (int i = 0; i < numPoints; i++) {
+            if (points[i].x != static_cast<uint64_t>(i + 1)) return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * t-subsets of {0..n-1} in revolving-door order (Knuth, TAOCP 7.2.1.3,
+ * Algorithm R): each subset differs from the previous one by one element
+ * leaving and one entering, so per-subset state can be updated instead of
+ * rebuilt. The order follows Γ(n, t) = Γ(n-1, t), then Γ(n-1, t-1) reversed
+ * with n-1 added, which makes any rank directly seekable and lets the whole
+ * sequence be cut into independent chunks.
+ */
+class RevolvingDoor {
+public:
+    RevolvingDoor(size_t n, size_t t) : n_(n), t_(t), c_(t + 2) {
+        if (t > n) throw std::invalid_argument("Subset size exceeds the set size");
+        seek(0);
+    }
+
+    /**
+     * C(n, t), saturating at UINT64_MAX
+     */
+    static uint64_t binomial(size_t n, size_t t) {
+        if (t > n) return 0;
+        t = std::min(t, n - t);
+        unsigned __int128 result = 1;
+        for (size_t i = 1; i <= t; i++) {
+            // C(n-t+i, i) = C(n-t+i-1, i-1) * (n-t+i) / i stays exact at every step
+            result = result * (n - t + i) / i;
+            if (result > UINT64_MAX) return UINT64_MAX;
+        }
+        return static_cast<uint64_t>(result);
+    }
+
+    // Elements of the current subset, in increasing order
+    size_t operator[](size_t i) const { return c_[i + 1]; }
+
+    /**
+     * Moves to the subset at `rank` (0 <= rank < C(n, t))
+     */
+    void seek(uint64_t rank) {
+        size_t n = n_, t = t_;
+        bool reversed = false;
+        c_[t_ + 1] = n_;
+        while (t > 0) {
+            if (t == n) {
+                for (size_t i = 1; i <= t; i++) c_[i] = i - 1;
+                break;
+            }
+            // Forward: Γ(n-1, t) first; reversed: the subsets holding n-1 first
+            uint64_t first = reversed ? binomial(n - 1, t - 1) : binomial(n - 1, t);
+            bool holdsLast = (rank < first) == reversed;
+            if (rank >= first) rank -= first;
+            if (holdsLast) {
+                c_[t--] = n - 1;
+                reversed = !reversed;
+            }
+            n--;
+        }
+    }
+
+    /**
+     * Steps to the next subset, reporting the element that left and the one
+     * that entered; false after the last subset
+     */
+    bool next(size_t& removed, size_t& added) {
+        std::vector<size_t>& c = c_;
+        if (t_ == 0 || t_ == n_) return false;
+        if (t_ % 2 == 1) {
+            if (c[1] + 1 < c[2]) {
+                removed = c[1]++;
+                added = c[1];
+                return true;
+            }
+        } else if (c[1] > 0) {
+            removed = c[1]--;
+            added = c[1];
+            return true;
+        }
+        // Odd t tries to decrease c[2] first, even t to increase it; then alternate upwards
+        bool decrease = t_ % 2 == 1;
+        for (size_t j = 2; j <= t_; j++, decrease = !decrease) {
+            if (decrease && c[j] >= j) {
+                // c[j] = c[j-1] + 1: {c[j-1], c[j]} -> {j-2, c[j-1]}
+                removed = c[j];
+                added = j - 2;
+                c[j] = c[j - 1];
+                c[j - 1] = j - 2;
+                return true;
+            }
+            if (!decrease && c[j] + 1 < c[j + 1]) {
+                // c[j-1] = j-2: {j-2, c[j]} -> {c[j], c[j]+1}
+                removed = j - 2;
+                added = c[j] + 1;
+                c[j - 1] = c[j];
+                c[j]++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    size_t n_, t_;
+    std::vector<size_t> c_;  // c_[1..t] ascending, c_[t+1] = n as a sentinel
+};
+
+/**
+ * Digit validation and packing kernels for decodeFromBase
+ * toDigits maps characters to digit values and checks all of them against the
+ * base with one unsigned vector compare; packGroups folds every 4 digits into a
+ * 32-bit group value d0*b^3 + d1*b^2 + d2*b + d3 with multiply-add shuffles
+ * (valid for any base up to 36). The widest instruction set available at
+ * runtime (AVX-512BW, AVX2, SSE4.2) is chosen once; other CPUs use the
+ * portable table-driven scalar code.
+ */
+class DigitKernels {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * digits[i] = value of text[i]; returns the index of the first character that
+     * is not a valid digit for base, or npos
+     */
+    static size_t toDigits(const char* text, size_t length, int base, uint8_t* digits) {
+        return dispatch().toDigits(text, length, base, digits);
+    }
+
+    /**
+     * groups[g] = base-b value of digits[4g..4g+4)
+     */
+    static void packGroups(const uint8_t* digits, size_t groupCount, int base, uint32_t* groups) {
+        dispatch().packGroups(digits, groupCount, base, groups);
+    }
+
+    static const char* instructionSet() { return dispatch().name; }
+
+private:
+    struct Implementation {
+        const char* name;
+        size_t (*toDigits)(const char*, size_t, int, uint8_t*);
+        void (*packGroups)(const uint8_t*, size_t, int, uint32_t*);
+    };
+
+    static const Implementation& dispatch() {
+        static const Implementation selected = select();
+        return selected;
+    }
+
+    static Implementation select() {
+#if POLY_SOLVER_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512bw")) return {"AVX-512BW", toDigitsAvx512, packGroupsAvx512};
+        if (__builtin_cpu_supports("avx2")) return {"AVX2", toDigitsAvx2, packGroupsAvx2};
+        if (__builtin_cpu_supports("sse4.2")) return {"SSE4.2", toDigitsSse42, packGroupsSse42};
+#endif
+        return {"scalar", toDigitsScalar, packGroupsScalar};
+    }
+
+    // Character -> digit value, 0xFF for characters that are never digits
+    static const std::array<uint8_t, 256>& digitTable() {
+        static const std::array<uint8_t, 256> table = [] {
+            std::array<uint8_t, 256> values;
+            values.fill(0xFF);
+            for (int c = '0'; c <= '9'; c++) values[c] = static_cast<uint8_t>(c - '0');
+            for (int c = 'a'; c <= 'z'; c++) values[c] = static_cast<uint8_t>(c - 'a' + 10);
+            for (int c = 'A'; c <= 'Z'; c++) values[c] = static_cast<uint8_t>(c - 'A' + 10);
+            return values;
+        }();
+        return table;
+    }
+
+    static size_t toDigitsScalar(const char* text, size_t length, int base, uint8_t* digits) {
+        const std::array<uint8_t, 256>& table = digitTable();
+        for (size_t i = 0; i < length; i++) {
+            uint8_t digit = table[static_cast<unsigned char>(text[i])];
+            if (digit >= base) return i;
+            digits[i] = digit;
+        }
+        return npos;
+    }
+
+    static void packGroupsScalar(const uint8_t* digits, size_t groupCount, int base, uint32_t* groups) {
+        const uint32_t b = static_cast<uint32_t>(base);
+        for (size_t g = 0; g < groupCount; g++) {
+            const uint8_t* d = digits + 4 * g;
+            groups[g] = ((d[0] * b + d[1]) * b + d[2]) * b + d[3];
+        }
+    }
+
+    // Finishes a vector kernel's tail with the scalar code
+    static size_t finishScalar(const char* text, size_t length, int base, uint8_t* digits, size_t done) {
+        size_t invalid = toDigitsScalar(text + done, length - done, base, digits + done);
+        return invalid == npos ? npos : done + invalid;
+    }
+
+#if POLY_SOLVER_X86_SIMD
+    __attribute__((target("sse4.2")))
+    static size_t toDigitsSse42(const char* text, size_t length, int base, uint8_t* digits) {
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        const __m128i lowerA = _mm_set1_epi8('a');
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i twentyFive = _mm_set1_epi8(25);
+        const __m128i ten = _mm_set1_epi8(10);
+        const __m128i invalid = _mm_set1_epi8(static_cast<char>(0xFF));
+        const __m128i maxDigit = _mm_set1_epi8(static_cast<char>(base - 1));
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            __m128i decimal = _mm_sub_epi8(c, zeroChar);
+            __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, caseBit), lowerA);
+            __m128i isDecimal = _mm_cmpeq_epi8(_mm_min_epu8(decimal, nine), decimal);
+            __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, twentyFive), alpha);
+            __m128i d = _mm_blendv_epi8(invalid, _mm_add_epi8(alpha, ten), isAlpha);
+            d = _mm_blendv_epi8(d, decimal, isDecimal);
+            unsigned valid = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, maxDigit), d)));
+            if (valid != 0xFFFFu) return i + static_cast<size_t>(__builtin_ctz(~valid));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(digits + i), d);
+        }
+        return finishScalar(text, length, base, digits, i);
+    }
+
+    __attribute__((target("sse4.2")))
+    static void packGroupsSse42(const uint8_t* digits, size_t groupCount, int base, uint32_t* groups) {
+        const __m128i pairWeights = _mm_set1_epi16(static_cast<short>((1 << 8) | base));
+        const __m128i quadWeights = _mm_set1_epi32((1 << 16) | (base * base));
+        size_t g = 0;
+        for (; g + 4 <= groupCount; g += 4) {
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits + 4 * g));
+            __m128i pairs = _mm_maddubs_epi16(d, pairWeights);   // d0*b + d1
+            __m128i quads = _mm_madd_epi16(pairs, quadWeights);  // p0*b^2 + p1
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(groups + g), quads);
+        }
+        packGroupsScalar(digits + 4 * g, groupCount - g, base, groups + g);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t toDigitsAvx2(const char* text, size_t length, int base, uint8_t* digits) {
+        const __m256i zeroChar = _mm256_set1_epi8('0');
+        const __m256i lowerA = _mm256_set1_epi8('a');
+        const __m256i caseBit = _mm256_set1_epi8(0x20);
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i twentyFive = _mm256_set1_epi8(25);
+        const __m256i ten = _mm256_set1_epi8(10);
+        const __m256i invalid = _mm256_set1_epi8(static_cast<char>(0xFF));
+        const __m256i maxDigit = _mm256_set1_epi8(static_cast<char>(base - 1));
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+            __m256i decimal = _mm256_sub_epi8(c, zeroChar);
+            __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, caseBit), lowerA);
+            __m256i isDecimal = _mm256_cmpeq_epi8(_mm256_min_epu8(decimal, nine), decimal);
+            __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, twentyFive), alpha);
+            __m256i d = _mm256_blendv_epi8(invalid, _mm256_add_epi8(alpha, ten), isAlpha);
+            d = _mm256_blendv_epi8(d, decimal, isDecimal);
+            uint32_t valid = static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(d, maxDigit), d)));
+            if (valid != 0xFFFFFFFFu) return i + static_cast<size_t>(__builtin_ctz(~valid));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(digits + i), d);
+        }
+        return finishScalar(text, length, base, digits, i);
+    }
+
+    __attribute__((target("avx2")))
+    static void packGroupsAvx2(const uint8_t* digits, size_t groupCount, int base, uint32_t* groups) {
+        const __m256i pairWeights = _mm256_set1_epi16(static_cast<short>((1 << 8) | base));
+        const __m256i quadWeights = _mm256_set1_epi32((1 << 16) | (base * base));
+        size_t g = 0;
+        for (; g + 8 <= groupCount; g += 8) {
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + 4 * g));
+            __m256i quads = _mm256_madd_epi16(_mm256_maddubs_epi16(d, pairWeights), quadWeights);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(groups + g), quads);
+        }
+        packGroupsScalar(digits + 4 * g, groupCount - g, base, groups + g);
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    static size_t toDigitsAvx512(const char* text, size_t length, int base, uint8_t* digits) {
+        const __m512i zeroChar = _mm512_set1_epi8('0');
+        const __m512i lowerA = _mm512_set1_epi8('a');
+        const __m512i caseBit = _mm512_set1_epi8(0x20);
+        const __m512i nine = _mm512_set1_epi8(9);
+        const __m512i twentyFive = _mm512_set1_epi8(25);
+        const __m512i ten = _mm512_set1_epi8(10);
+        const __m512i invalid = _mm512_set1_epi8(static_cast<char>(0xFF));
+        const __m512i maxDigit = _mm512_set1_epi8(static_cast<char>(base - 1));
+        size_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i c = _mm512_loadu_si512(text + i);
+            __m512i decimal = _mm512_sub_epi8(c, zeroChar);
+            __m512i alpha = _mm512_sub_epi8(_mm512_or_si512(c, caseBit), lowerA);
+            __mmask64 isDecimal = _mm512_cmple_epu8_mask(decimal, nine);
+            __mmask64 isAlpha = _mm512_cmple_epu8_mask(alpha, twentyFive);
+            __m512i d = _mm512_mask_blend_epi8(isAlpha, invalid, _mm512_add_epi8(alpha, ten));
+            d = _mm512_mask_blend_epi8(isDecimal, d, decimal);
+            uint64_t valid = _mm512_cmple_epu8_mask(d, maxDigit);
+            if (valid != ~uint64_t(0)) return i + static_cast<size_t>(__builtin_ctzll(~valid));
+            _mm512_storeu_si512(digits + i, d);
+        }
+        return finishScalar(text, length, base, digits, i);
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    static void packGroupsAvx512(const uint8_t* digits, size_t groupCount, int base, uint32_t* groups) {
+        const __m512i pairWeights = _mm512_set1_epi16(static_cast<short>((1 << 8) | base));
+        const __m512i quadWeights = _mm512_set1_epi32((1 << 16) | (base * base));
+        size_t g = 0;
+        for (; g + 16 <= groupCount; g += 16) {
+            __m512i d = _mm512_loadu_si512(digits + 4 * g);
+            __m512i quads = _mm512_madd_epi16(_mm512_maddubs_epi16(d, pairWeights), quadWeights);
+            _mm512_storeu_si512(groups + g, quads);
+        }
+        packGroupsScalar(digits + 4 * g, groupCount - g, base, groups + g);
+    }
+#endif
+};
+
+/**
+ * Read-only bytes of an input file
+ * Regular files are mapped with mmap and MADV_SEQUENTIAL, so the parser reads
+ * straight out of the page cache without copying. Pipes, stdin ("-") and
+ * anything else that cannot be mapped are read into a heap buffer behind the
+ * same interface.
+ */
+class InputBuffer {
+public:
+    static InputBuffer open(const std::string& filename) {
+        InputBuffer input;
+        if (filename == "-") {
+            input.heap_.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+            input.data_ = input.heap_.data();
+            input.size_ = input.heap_.size();
+            return input;
+        }
+#if POLY_SOLVER_HAVE_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            size_t size = static_cast<size_t>(info.st_size);
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                ::madvise(mapping, size, MADV_SEQUENTIAL);
+                ::close(fd);
+                input.data_ = static_cast<const char*>(mapping);
+                input.size_ = size;
+                input.mapped_ = true;
+                return input;
+            }
+        }
+        // Not mappable (pipe, FIFO, empty or special file): read it instead
+        char chunk[1 << 16];
+        ssize_t count;
+        while ((count = ::read(fd, chunk, sizeof(chunk))) > 0) {
+            input.heap_.insert(input.heap_.end(), chunk, chunk + count);
+        }
+        ::close(fd);
+        if (count < 0) {
+            throw std::runtime_error("Cannot read file: " + filename);
+        }
+#else
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+        input.heap_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+#endif
+        input.data_ = input.heap_.data();
+        input.size_ = input.heap_.size();
+        return input;
+    }
+
+    // Takes ownership of text assembled in memory
+    static InputBuffer fromBytes(std::vector<char> bytes) {
+        InputBuffer input;
+        input.heap_ = std::move(bytes);
+        input.data_ = input.heap_.data();
+        input.size_ = input.heap_.size();
+        return input;
+    }
+
+    InputBuffer() = default;
+
+    InputBuffer(InputBuffer&& other) noexcept { *this = std::move(other); }
+
+    InputBuffer& operator=(InputBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            heap_ = std::move(other.heap_);
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_ = other.mapped_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mapped_ = false;
+        }
+        return *this;
+    }
+
+    InputBuffer(const InputBuffer&) = delete;
+    InputBuffer& operator=(const InputBuffer&) = delete;
+
+    ~InputBuffer() { release(); }
+
+    std::string_view text() const { return std::string_view(data_, size_); }
+    bool isMapped() const { return mapped_; }
+
+private:
+    void release() {
+#if POLY_SOLVER_HAVE_MMAP
+        if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+        mapped_ = false;
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<char> heap_;  // backing store when the file is not mapped
+};
+
+/**
+ * Magnitude tier of a decoded value
+ * Word/DoubleWord values fit in signed 64/128-bit integers and are carried as a
+ * machine integer, which the interpolation loops read directly. Only Big values
+ * use BigInteger arithmetic.
+ */
+enum class ValueTier : uint8_t { Word, DoubleWord, Big };
+
+/**
+ * A decoded value tagged with its tier: `small` holds Word/DoubleWord values
+ * and `big` is only built for the Big tier
+ */
+struct TieredValue {
+    ValueTier tier = ValueTier::Word;
+    __int128 small = 0;  // the value unless tier is Big (then 0)
+    BigInt big;          // the value when tier is Big (empty otherwise)
+
+    TieredValue() = default;
+
+    explicit TieredValue(BigInt value) {
+        size_t bits = value.bitLength();
+        if (bits > 126) {
+            tier = ValueTier::Big;
+            big = std::move(value);
+        } else {
+            tier = bits <= 63 ? ValueTier::Word : ValueTier::DoubleWord;
+            small = value.toInt128();
+        }
+    }
+
+    static TieredValue fromUnsigned128(unsigned __int128 value) {
+        if (value >> 126) return TieredValue(BigInt::fromUnsigned128(value));
+        TieredValue result;
+        result.tier = value >> 63 ? ValueTier::DoubleWord : ValueTier::Word;
+        result.small = static_cast<__int128>(value);
+        return result;
+    }
+
+    BigInt toBigInt() const { return tier == ValueTier::Big ? big : BigInt::fromInt128(small); }
+
+    size_t bitLength() const {
+        if (tier == ValueTier::Big) return big.bitLength();
+        unsigned __int128 magnitude = small < 0 ? -static_cast<unsigned __int128>(small) : small;
+        uint64_t high = static_cast<uint64_t>(magnitude >> 64), low = static_cast<uint64_t>(magnitude);
+        if (high != 0) return 128 - __builtin_clzll(high);
+        return low == 0 ? 0 : 64 - __builtin_clzll(low);
+    }
+
+    std::string toString() const { return toBigInt().toString(); }
+};
+
+/**
+ * The shares of one test case as a struct of arrays
+ * x-coordinates, bases and value slices are parallel columns; a value slice is
+ * an offset/length pair into the text the shares were parsed from, which the
+ * table can own. Decoded y-values are stored back to back in one limb arena, so
+ * a table of n shares costs a handful of allocations instead of n.
+ */
+class ShareTable {
+public:
+    using Limb = BigInt::Limb;
+
+    ShareTable() = default;
+
+    // Takes ownership of the input the share values will point into
+    explicit ShareTable(InputBuffer source) : source_(std::move(source)) { text_ = source_.text(); }
+
+    ShareTable(ShareTable&&) = default;
+    ShareTable& operator=(ShareTable&&) = default;
+    ShareTable(const ShareTable&) = delete;
+    ShareTable& operator=(const ShareTable&) = delete;
+
+    // Text that added value slices must lie in (not owned unless passed to the constructor)
+    std::string_view text() const { return text_; }
+    void setText(std::string_view text) { text_ = text; }
+
+    size_t size() const { return x_.size(); }
+    bool empty() const { return x_.empty(); }
+
+    void clear() {
+        x_.clear();
+        base_.clear();
+        valueOffset_.clear();
+        valueLength_.clear();
+        yOffset_.clear();
+        yLength_.clear();
+        arena_.clear();
+    }
+
+    /**
+     * Appends a share whose digits `value` (in `base`) are a slice of text()
+     */
+    void add(uint64_t x, int base, std::string_view value) {
+        if (value.size() > UINT32_MAX) {
+            throw std::invalid_argument("Share value too long: " + std::to_string(value.size()) + " digits");
+        }
+        x_.push_back(x);
+        base_.push_back(static_cast<uint8_t>(base));
+        valueOffset_.push_back(value.empty() ? 0 : static_cast<uint64_t>(value.data() - text_.data()));
+        valueLength_.push_back(static_cast<uint32_t>(value.size()));
+        yOffset_.push_back(0);
+        yLength_.push_back(kNotDecoded);
+    }
+
+    /**
+     * Appends a share that is already decoded (no source digits)
+     */
+    void add(uint64_t x, const BigInt& y) {
+        add(x, 0, std::string_view());
+        setY(size() - 1, TieredValue(y));
+    }
+
+    uint64_t x(size_t i) const { return x_[i]; }
+    int base(size_t i) const { return base_[i]; }
+    std::string_view value(size_t i) const { return text_.substr(valueOffset_[i], valueLength_[i]); }
+
+    bool isDecoded(size_t i) const { return yLength_[i] != kNotDecoded; }
+
+    // Size of share i's value in bits: digits * log2(base) before decoding, whole limbs after
+    double estimatedBits(size_t i) const {
+        if (isDecoded(i)) return 64.0 * yLength_[i];
+        return valueLength_[i] * std::log2(static_cast<double>(base_[i]));
+    }
+
+    /**
+     * Stores share i's decoded value (non-negative) at the end of the arena
+     */
+    void setY(size_t i, const TieredValue& y) {
+        yOffset_[i] = arena_.size();
+        if (y.tier == ValueTier::Big) {
+            yLength_[i] = static_cast<uint32_t>(y.big.limbCount());
+            for (size_t j = 0; j < y.big.limbCount(); j++) arena_.push_back(y.big.limb(j));
+            return;
+        }
+        unsigned __int128 magnitude = static_cast<unsigned __int128>(y.small);
+        yLength_[i] = 0;
+        for (; magnitude != 0; magnitude >>= 64, yLength_[i]++) arena_.push_back(static_cast<Limb>(magnitude));
+    }
+
+    // Share i's decoded value; a BigInteger is only built for the Big tier
+    TieredValue y(size_t i) const {
+        if (!isDecoded(i)) {
+            throw std::logic_error("Share " + std::to_string(x_[i]) + " has not been decoded");
+        }
+        const Limb* limbs = arena_.data() + yOffset_[i];
+        switch (yLength_[i]) {
+            case 0: return TieredValue();
+            case 1: return TieredValue::fromUnsigned128(limbs[0]);
+            case 2: return TieredValue::fromUnsigned128((static_cast<unsigned __int128>(limbs[1]) << 64) | limbs[0]);
+            default: return TieredValue(BigInt::fromLimbs(limbs, yLength_[i]));
+        }
+    }
+
+    // "(x, y)" for share i, or "(x, <digits> in base b)" while it is still undecoded
+    std::string pointString(size_t i) const {
+        if (!isDecoded(i)) {
+            return "(" + std::to_string(x_[i]) + ", " + std::string(value(i)) + " in base " +
+                   std::to_string(base_[i]) + ")";
+        }
+        return "(" + std::to_string(x_[i]) + ", " + y(i).toString() + ")";
+    }
+
+    /**
+     * Reorders every column by ascending x (stable); exported files are usually
+     * sorted already, which is checked first
+     */
+    void sortByX() {
+        if (std::is_sorted(x_.begin(), x_.end())) return;
+        std::vector<uint32_t> order(size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+        std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return x_[a] < x_[b]; });
+        permute(x_, order);
+        permute(base_, order);
+        permute(valueOffset_, order);
+        permute(valueLength_, order);
+        permute(yOffset_, order);
+        permute(yLength_, order);
+    }
+
+    // Position of the first share whose x equals its predecessor's (sorted tables), or size()
+    size_t findDuplicateX() const {
+        auto duplicate = std::adjacent_find(x_.begin(), x_.end());
+        return static_cast<size_t>(duplicate - x_.begin());
+    }
+
+private:
+    static constexpr uint32_t kNotDecoded = UINT32_MAX;
+
+    template <typename T>
+    static void permute(std::vector<T>& column, const std::vector<uint32_t>& order) {
+        std::vector<T> reordered(column.size());
+        for (size_t i = 0; i < order.size(); i++) reordered[i] = column[order[i]];
+        column.swap(reordered);
+    }
+
+    InputBuffer source_;
+    std::string_view text_;
+    std::vector<uint64_t> x_;            // share index = x-coordinate
+    std::vector<uint8_t> base_;          // 2..36 (0 for shares added already decoded)
+    std::vector<uint64_t> valueOffset_;  // digits within text_
+    std::vector<uint32_t> valueLength_;
+    std::vector<uint64_t> yOffset_;      // decoded value within arena_
+    std::vector<uint32_t> yLength_;      // in limbs; kNotDecoded until setY
+    std::vector<Limb> arena_;
+};
+
+/**
+ * Simple JSON Parser for our specific use case
+ * Single-pass tokenizer over the file contents - no regex, no whitespace-stripping
+ * copy and no intermediate map. Share entries go straight into the document's
+ * ShareTable, with the values left as slices of the input. Members may appear in any order,
+ * whitespace is free-form, numbers may be quoted or bare, and unknown members
+ * are skipped.
+ *
+ * Large inputs use a two-stage parser instead: stage 1 finds the structural
+ * characters (quotes, braces, brackets, colons and commas outside strings) 64
+ * bytes at a time with SIMD bitmasks; stage 2 walks that index with the same
+ * grammar as the byte scanner, one cache-sized window at a time.
+ */
+class SimpleJsonParser {
+public:
+    // Inputs from this size on are parsed through the structural index
+    static constexpr size_t kStructuralIndexMinBytes = 64 * 1024;
+    // 64-byte blocks indexed per stage 1 window (16 KiB of text)
+    static constexpr size_t kStructuralWindowBlocks = 256;
+
+    /**
+     * One "<index>": {"base": ..., "value": ...} entry
+     */
+    struct ShareRecord {
+        uint64_t index;          // x-coordinate of the share
+        int base;                // 2..36
+        std::string_view value;  // digits in that base
+    };
+
+    /**
+     * Top-level members other than the shares, as the grammar collects them
+     */
+    struct Header {
+        int n = 0;
+        int k = 0;
+        bool sawN = false;
+        bool sawK = false;
+        std::string_view prime;
+    };
+
+    /**
+     * A parsed test case; `prime` and the share values point into shares.text()
+     */
+    struct Document {
+        int n = 0;
+        int k = 0;
+        std::string_view prime;  // empty unless the shares are over GF(p)
+        ShareTable shares;       // in file order
+    };
+
+    /**
+     * Maps (or reads, for pipes and "-" = stdin) a test case file and tokenizes it;
+     * the document's share table owns the input
+     */
+    static Document parseTestCase(const std::string& filename) {
+        Document document;
+        document.shares = ShareTable(InputBuffer::open(filename));
+        std::string_view text = document.shares.text();
+        if (text.size() >= kStructuralIndexMinBytes) {
+            parseIndexed(text, document);
+        } else {
+            parse(text, document);
+        }
+        return document;
+    }
+
+    /**
+     * Tokenizes a JSON test case held in `text` byte by byte; the records reference `text`
+     */
+    static void parse(std::string_view text, Document& document) {
+        document.shares.setText(text);
+        Scanner scanner(text);
+        parseDocument(scanner, document);
+    }
+
+    /**
+     * Two-stage parse of `text`: the grammar walks a structural index that is
+     * built window by window just ahead of it, so the index stays cache-sized
+     */
+    static void parseIndexed(std::string_view text, Document& document) {
+        document.shares.setText(text);
+        IndexCursor cursor(text);
+        parseDocument(cursor, document);
+    }
+
+    /**
+     * Stage 1: offsets of every structural character ({ } [ ] : , and unescaped
+     * quotes) and of the first byte of every bare token outside string literals,
+     * produced a window of 64-byte blocks at a time
+     */
+    class StructuralIndexer {
+    public:
+        explicit StructuralIndexer(std::string_view text) : text_(text) {}
+
+        bool finished() const { return offset_ >= text_.size(); }
+
+        /**
+         * Writes the structural offsets of up to `blocks` further 64-byte blocks to
+         * `out` and returns how many there were. `out` needs room for 64 * blocks
+         * entries: a block yields at most 64, stored eight at a time without
+         * per-entry bounds checks.
+         */
+        size_t next(size_t* out, size_t blocks) {
+            const StructuralClassifier& classifier = structuralClassifier();
+            size_t count = 0;
+            char tail[64];
+            for (size_t b = 0; b < blocks && offset_ < text_.size(); b++, offset_ += 64) {
+                const char* block = text_.data() + offset_;
+                if (text_.size() - offset_ < 64) {
+                    std::memset(tail, ' ', sizeof(tail));
+                    std::memcpy(tail, block, text_.size() - offset_);
+                    block = tail;
+                }
+                BlockMasks masks = classifier.classify(block);
+
+                // A character is escaped when an odd-length backslash run precedes it
+                // (the run-length parity trick from simdjson's escape scanner)
+                uint64_t escaped;
+                if (masks.backslashes == 0) {
+                    escaped = nextIsEscaped_;
+                    nextIsEscaped_ = 0;
+                } else {
+                    const uint64_t oddBits = 0xAAAAAAAAAAAAAAAAULL;
+                    uint64_t potentialEscape = masks.backslashes & ~nextIsEscaped_;
+                    uint64_t escapeCodes = (((potentialEscape << 1) | oddBits) - potentialEscape) ^ oddBits;
+                    escaped = escapeCodes ^ (masks.backslashes | nextIsEscaped_);
+                    nextIsEscaped_ = (escapeCodes & masks.backslashes) >> 63;
+                }
+
+                // Bits from each opening quote up to (not including) its closing quote
+                uint64_t quotes = masks.quotes & ~escaped;
+                uint64_t inString = prefixXor(quotes) ^ inStringCarry_;
+                inStringCarry_ = 0 - (inString >> 63);
+
+                // Bare tokens (numbers, literals, stray text) are indexed by their
+                // first byte, so stage 2 sees anything between two structurals
+                uint64_t tokenBytes = ~(masks.operators | masks.whitespace | quotes | inString);
+                uint64_t tokenStarts = tokenBytes & ~((tokenBytes << 1) | tokenCarry_);
+                tokenCarry_ = tokenBytes >> 63;
+
+                uint64_t structurals = (masks.operators & ~inString) | quotes | tokenStarts;
+                size_t* write = out + count;
+                count += static_cast<size_t>(__builtin_popcountll(structurals));
+                while (structurals != 0) {
+                    for (int i = 0; i < 8; i++) {
+                        write[i] = offset_ + static_cast<size_t>(__builtin_ctzll(structurals | (uint64_t(1) << 63)));
+                        structurals &= structurals - 1;
+                    }
+                    write += 8;
+                }
+            }
+            if (finished() && inStringCarry_ != 0) {
+                throw std::runtime_error("JSON parsing failed: unterminated string");
+            }
+            return count;
+        }
+
+    private:
+        std::string_view text_;
+        size_t offset_ = 0;
+        uint64_t nextIsEscaped_ = 0;  // the next block's first byte follows an escaping backslash
+        uint64_t inStringCarry_ = 0;  // all ones while a string continues into the next block
+        uint64_t tokenCarry_ = 0;     // the previous block ended inside a bare token
+    };
+
+    // Instruction set used by stage 1 on this CPU
+    static const char* structuralInstructionSet() { return structuralClassifier().name; }
+
+private:
+    /**
+     * Per-block bitmasks; bit i describes byte i of the 64-byte block
+     */
+    struct BlockMasks {
+        uint64_t quotes;
+        uint64_t backslashes;
+        uint64_t operators;   // { } [ ] : ,
+        uint64_t whitespace;  // space, \t, \n, \r
+    };
+
+    struct StructuralClassifier {
+        const char* name;
+        BlockMasks (*classify)(const char*);
+    };
+
+    static const StructuralClassifier& structuralClassifier() {
+        static const StructuralClassifier selected = [] {
+#if POLY_SOLVER_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512bw")) return StructuralClassifier{"AVX-512BW", classifyAvx512};
+            if (__builtin_cpu_supports("avx2")) return StructuralClassifier{"AVX2", classifyAvx2};
+#endif
+            return StructuralClassifier{"scalar", classifyScalar};
+        }();
+        return selected;
+    }
+
+    // Bit i = XOR of bits 0..i
+    static uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    static BlockMasks classifyScalar(const char* block) {
+        BlockMasks masks{0, 0, 0, 0};
+        for (unsigned i = 0; i < 64; i++) {
+            char c = block[i];
+            uint64_t bit = uint64_t(1) << i;
+            if (c == '"') masks.quotes |= bit;
+            if (c == '\\') masks.backslashes |= bit;
+            if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') masks.operators |= bit;
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') masks.whitespace |= bit;
+        }
+        return masks;
+    }
+
+#if POLY_SOLVER_X86_SIMD
+    // c | 0x20 folds '[' onto '{' and ']' onto '}', so four compares find all operators
+    __attribute__((target("avx2")))
+    static uint32_t operatorMaskAvx2(__m256i bytes) {
+        __m256i folded = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+        __m256i braces = _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+                                         _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}')));
+        __m256i separators = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')),
+                                             _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(',')));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(braces, separators)));
+    }
+
+    __attribute__((target("avx2")))
+    static uint32_t whitespaceMaskAvx2(__m256i bytes) {
+        __m256i blanks = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                                         _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')));
+        __m256i breaks = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')),
+                                         _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r')));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(blanks, breaks)));
+    }
+
+    __attribute__((target("avx2")))
+    static BlockMasks classifyAvx2(const char* block) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        auto combine = [](int lowBits, int highBits) {
+            return static_cast<uint64_t>(static_cast<uint32_t>(lowBits)) |
+                   (static_cast<uint64_t>(static_cast<uint32_t>(highBits)) << 32);
+        };
+        BlockMasks masks;
+        masks.quotes = combine(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, quote)),
+                               _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, quote)));
+        masks.backslashes = combine(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, backslash)),
+                                    _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, backslash)));
+        masks.operators = combine(static_cast<int>(operatorMaskAvx2(low)), static_cast<int>(operatorMaskAvx2(high)));
+        masks.whitespace =
+            combine(static_cast<int>(whitespaceMaskAvx2(low)), static_cast<int>(whitespaceMaskAvx2(high)));
+        return masks;
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    static BlockMasks classifyAvx512(const char* block) {
+        __m512i bytes = _mm512_loadu_si512(block);
+        __m512i folded = _mm512_or_si512(bytes, _mm512_set1_epi8(0x20));
+        BlockMasks masks;
+        masks.quotes = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('"'));
+        masks.backslashes = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\\'));
+        masks.operators = _mm512_cmpeq_epi8_mask(folded, _mm512_set1_epi8('{')) |
+                          _mm512_cmpeq_epi8_mask(folded, _mm512_set1_epi8('}')) |
+                          _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(':')) |
+                          _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(','));
+        masks.whitespace = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(' ')) |
+                           _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\t')) |
+                           _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\n')) |
+                           _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\r'));
+        return masks;
+    }
+#endif
+
+    /**
+     * Cursor over the raw text with the handful of JSON productions we need
+     */
+    class Scanner {
+    public:
+        // `origin` is the offset of `text` within the input, for error messages
+        explicit Scanner(std::string_view text, size_t origin = 0) : text_(text), origin_(origin), position_(0) {}
+
+        size_t position() const { return position_; }
+
+        // True once the cursor has run into the end of the text
+        bool exhausted() const { return position_ >= text_.size(); }
+
+        bool consume(char expected) {
+            skipWhitespace();
+            if (position_ < text_.size() && text_[position_] == expected) {
+                position_++;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char expected) {
+            if (!consume(expected)) fail(std::string("expected '") + expected + "'");
+        }
+
+        // Contents of a string literal (escape sequences are skipped over, not decoded)
+        std::string_view string() {
+            expect('"');
+            size_t start = position_;
+            while (position_ < text_.size() && text_[position_] != '"') {
+                position_ += text_[position_] == '\\' ? 2 : 1;
+            }
+            if (position_ >= text_.size()) fail("unterminated string");
+            return text_.substr(start, position_++ - start);
+        }
+
+        // A string's contents or a bare token (number, true, false, null)
+        std::string_view scalar() {
+            skipWhitespace();
+            if (position_ < text_.size() && text_[position_] == '"') return string();
+            size_t start = position_;
+            while (position_ < text_.size() && !isDelimiter(text_[position_])) position_ += escapeLength();
+            if (position_ == start) fail("expected a value");
+            return text_.substr(start, position_ - start);
+        }
+
+        // Only whitespace may follow the document
+        void expectEnd() {
+            skipWhitespace();
+            if (!exhausted()) fail("unexpected content after the document");
+        }
+
+        // Skips any value, including nested objects and arrays
+        void skipValue() {
+            skipWhitespace();
+            if (position_ >= text_.size()) fail("expected a value");
+            char c = text_[position_];
+            if (c == '"') {
+                string();
+            } else if (c == '{' || c == '[') {
+                size_t depth = 0;
+                do {
+                    c = text_[position_];
+                    if (c == '"') {
+                        string();
+                        continue;
+                    }
+                    if (c == '{' || c == '[') depth++;
+                    if (c == '}' || c == ']') depth--;
+                    position_ += escapeLength();
+                } while (depth > 0 && position_ < text_.size());
+                if (depth > 0) fail("unterminated container");
+            } else {
+                scalar();
+            }
+        }
+
+        [[noreturn]] void fail(const std::string& message) const {
+            throw std::runtime_error("JSON parsing failed: " + message + " at offset " + std::to_string(origin_ + position_));
+        }
+
+    private:
+        static bool isWhitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+        static bool isDelimiter(char c) {
+            return isWhitespace(c) || c == ',' || c == ':' || c == '}' || c == ']' || c == '{' || c == '[' || c == '"';
+        }
+
+        void skipWhitespace() {
+            while (position_ < text_.size() && isWhitespace(text_[position_])) position_++;
+        }
+
+        // Outside strings as well, a backslash escapes a following quote or
+        // backslash, as the structural index has it
+        size_t escapeLength() const {
+            bool escapes = text_[position_] == '\\' && position_ + 1 < text_.size() &&
+                           (text_[position_ + 1] == '"' || text_[position_ + 1] == '\\');
+            return escapes ? 2 : 1;
+        }
+
+        std::string_view text_;
+        size_t origin_;
+        size_t position_;
+    };
+
+    /**
+     * Stage 2 cursor: the Scanner interface driven by the structural index.
+     * Strings are the text between a quote and the next index entry; bare
+     * scalars run from their indexed first byte to the next whitespace or entry.
+     * Stray text between structurals is indexed too, so the cursor accepts
+     * exactly what the Scanner does, and positions errors the same way. Only the
+     * entry before the cursor is kept when the next window is indexed.
+     */
+    class IndexCursor {
+    public:
+        explicit IndexCursor(std::string_view text)
+            : text_(text), indexer_(text), index_(new size_t[1 + 64 * kStructuralWindowBlocks]), size_(0), next_(0),
+              position_(0) {}
+
+        bool consume(char expected) {
+            if (!available()) {
+                position_ = text_.size();
+                return false;
+            }
+            position_ = index_[next_];
+            if (text_[position_] != expected) return false;
+            position_++;
+            next_++;
+            return true;
+        }
+
+        void expect(char expected) {
+            if (!consume(expected)) fail(std::string("expected '") + expected + "'");
+        }
+
+        std::string_view string() {
+            expect('"');
+            if (!available()) fail("unterminated string");
+            size_t start = position_;
+            position_ = index_[next_++] + 1;
+            return text_.substr(start, position_ - 1 - start);
+        }
+
+        std::string_view scalar() {
+            if (!available()) {
+                position_ = text_.size();
+                fail("expected a value");
+            }
+            position_ = index_[next_];
+            if (text_[position_] == '"') return string();
+            if (isStructural(text_[position_])) fail("expected a value");
+            size_t start = index_[next_++];
+            size_t end = available() ? index_[next_] : text_.size();
+            while (position_ < end && !isWhitespace(text_[position_])) position_++;
+            return text_.substr(start, position_ - start);
+        }
+
+        void skipValue() {
+            if (!available()) {
+                position_ = text_.size();
+                fail("expected a value");
+            }
+            char c = text_[index_[next_]];
+            if (c == '"') {
+                string();
+            } else if (c == '{' || c == '[') {
+                size_t depth = 0;
+                do {
+                    position_ = index_[next_] + 1;
+                    c = text_[index_[next_++]];
+                    if (c == '{' || c == '[') depth++;
+                    if (c == '}' || c == ']') depth--;
+                } while (depth > 0 && available());
+                if (depth > 0) fail("unterminated container");
+            } else {
+                scalar();
+            }
+        }
+
+        void expectEnd() {
+            if (available()) {
+                position_ = index_[next_];
+                fail("unexpected content after the document");
+            }
+        }
+
+        [[noreturn]] void fail(const std::string& message) const {
+            throw std::runtime_error("JSON parsing failed: " + message + " at offset " + std::to_string(position_));
+        }
+
+    private:
+        static bool isWhitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+        static bool isStructural(char c) {
+            return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+        }
+
+        // True when index_[next_] exists, indexing further windows as needed
+        bool available() {
+            while (next_ >= size_) {
+                if (indexer_.finished()) return false;
+                size_t kept = 0;
+                if (next_ > 0) {
+                    index_[0] = index_[next_ - 1];
+                    kept = next_ = 1;
+                }
+                size_ = kept + indexer_.next(index_.get() + kept, kStructuralWindowBlocks);
+            }
+            return true;
+        }
+
+        std::string_view text_;
+        StructuralIndexer indexer_;
+        std::unique_ptr<size_t[]> index_;  // current window, preceded by the last consumed entry
+        size_t size_;
+        size_t next_;
+        size_t position_;  // where the Scanner would stand, for error offsets
+    };
+
+    /**
+     * The test case grammar, shared by both cursors
+     */
+    template <typename Cursor>
+    static void parseDocument(Cursor& cursor, Document& document) {
+        Header header;
+        cursor.expect('{');
+        if (!cursor.consume('}')) {
+            do {
+                ShareRecord share{};
+                if (parseMember(cursor, header, share)) document.shares.add(share.index, share.base, share.value);
+            } while (cursor.consume(','));
+            cursor.expect('}');
+        }
+        cursor.expectEnd();
+        checkHeader(header);
+        document.n = header.n;
+        document.k = header.k;
+        document.prime = header.prime;
+    }
+
+    /**
+     * One member of the top-level object; returns true when it was a share entry,
+     * which is then stored in `share`
+     */
+    template <typename Cursor>
+    static bool parseMember(Cursor& cursor, Header& header, ShareRecord& share) {
+        std::string_view key = cursor.string();
+        cursor.expect(':');
+        if (key == "keys") {
+            cursor.expect('{');
+            if (!cursor.consume('}')) {
+                do {
+                    std::string_view member = cursor.string();
+                    cursor.expect(':');
+                    if (member == "n") {
+                        header.n = parseInteger(cursor, "keys.n");
+                        header.sawN = true;
+                    } else if (member == "k") {
+                        header.k = parseInteger(cursor, "keys.k");
+                        header.sawK = true;
+                    } else {
+                        cursor.skipValue();
+                    }
+                } while (cursor.consume(','));
+                cursor.expect('}');
+            }
+        } else if (key == "prime") {
+            header.prime = cursor.scalar();
+        } else if (isIndex(key)) {
+            share = parseShare(cursor, key);
+            return true;
+        } else {
+            cursor.skipValue();
+        }
+        return false;
+    }
+
+    static void checkHeader(const Header& header) {
+        if (!header.sawN || !header.sawK) {
+            throw std::runtime_error("JSON parsing failed: missing keys.n or keys.k");
+        }
+    }
+
+    template <typename Cursor>
+    static int parseInteger(Cursor& cursor, const char* name) {
+        std::string_view token = cursor.scalar();
+        long long value = 0;
+        for (char c : token) {
+            if (c < '0' || c > '9' || value > (INT32_MAX - (c - '0')) / 10) {
+                cursor.fail(std::string("invalid ") + name);
+            }
+            value = value * 10 + (c - '0');
+        }
+        if (token.empty()) cursor.fail(std::string("invalid ") + name);
+        return static_cast<int>(value);
+    }
+
+    static bool isIndex(std::string_view key) {
+        if (key.empty()) return false;
+        for (char c : key) {
+            if (c < '0' || c > '9') return false;
+        }
+        return true;
+    }
+
+    template <typename Cursor>
+    static ShareRecord parseShare(Cursor& cursor, std::string_view key) {
+        ShareRecord share{0, 0, std::string_view()};
+        for (char c : key) {
+            uint64_t digit = static_cast<uint64_t>(c - '0');
+            if (share.index > (UINT64_MAX - digit) / 10) cursor.fail("share index out of range");
+            share.index = share.index * 10 + digit;
+        }
+        bool sawBase = false, sawValue = false;
+        cursor.expect('{');
+        if (!cursor.consume('}')) {
+            do {
+                std::string_view member = cursor.string();
+                cursor.expect(':');
+                if (member == "base") {
+                    share.base = parseBase(cursor, key);
+                    sawBase = true;
+                } else if (member == "value") {
+                    share.value = cursor.scalar();
+                    sawValue = true;
+                } else {
+                    cursor.skipValue();
+                }
+            } while (cursor.consume(','));
+            cursor.expect('}');
+        }
+        if (!sawBase || !sawValue) cursor.fail("share " + std::string(key) + " needs both base and value");
+        return share;
+    }
+
+    template <typename Cursor>
+    static int parseBase(Cursor& cursor, std::string_view key) {
+        std::string_view token = cursor.scalar();
+        int base = 0;
+        for (char c : token) {
+            if (c < '0' || c > '9' || base > 36) {
+                base = 0;
+                break;
+            }
+            base = base * 10 + (c - '0');
+        }
+        if (base < 2 || base > 36) {
+            cursor.fail("unsupported base \"" + std::string(token) + "\" for share " + std::string(key));
+        }
+        return base;
+    }
+
+public:
+    /**
+     * Incremental pull parser for inputs too large to hold in memory: reads the
+     * file in fixed-size buffers and hands out each share as soon as its entry is
+     * complete. Consumed bytes are dropped at every refill, so memory follows the
+     * largest single entry rather than the file size. Entries go through the byte
+     * scanner; one that straddles a refill is parsed again once the rest of it has
+     * been read.
+     */
+    class ShareStream {
+    public:
+        static constexpr size_t kDefaultBufferBytes = 1 << 20;
+
+        /**
+         * Opens `filename` ("-" = stdin); nothing is read until the first next()
+         */
+        explicit ShareStream(const std::string& filename, size_t bufferBytes = kDefaultBufferBytes)
+            : filename_(filename),
+              file_(filename == "-" ? stdin : std::fopen(filename.c_str(), "rb")),
+              buffer_(std::max<size_t>(bufferBytes, 64)) {
+            if (!file_) {
+                throw std::runtime_error("Cannot open file: " + filename);
+            }
+        }
+
+        /**
+         * Advances to the next share entry; returns false once the document's
+         * closing brace and the whitespace after it have been read. The record's
+         * views stay valid until the following call.
+         */
+        bool next(ShareRecord& share) {
+            while (state_ != State::Done) {
+                Scanner scanner(std::string_view(buffer_.data() + begin_, end_ - begin_), offset_);
+                bool isShare;
+                try {
+                    isShare = step(scanner, share);
+                } catch (const std::runtime_error&) {
+                    // Ran out of buffered text mid-entry: read more and start the entry over
+                    if (eof_ || !scanner.exhausted()) throw;
+                    refill();
+                    continue;
+                }
+                begin_ += scanner.position();
+                offset_ += scanner.position();
+                if (isShare) return true;
+            }
+            while (begin_ < end_ || !eof_) {
+                Scanner(std::string_view(buffer_.data() + begin_, end_ - begin_), offset_).expectEnd();
+                offset_ += end_ - begin_;
+                begin_ = end_;
+                if (!eof_) refill();
+            }
+            checkHeader(header_);
+            return false;
+        }
+
+        // "keys" members; known once hasKeys() (always by the time next() returns false)
+        bool hasKeys() const { return header_.sawN && header_.sawK; }
+        int n() const { return header_.n; }
+        int k() const { return header_.k; }
+        const std::string& prime() const { return prime_; }
+
+        // Current buffer size; grows only when a single entry does not fit
+        size_t bufferBytes() const { return buffer_.size(); }
+
+    private:
+        enum class State { Open, Members, Done };
+
+        struct FileCloser {
+            void operator()(std::FILE* file) const {
+                if (file != stdin) std::fclose(file);
+            }
+        };
+
+        // Parses the next top-level step; progress is kept only if it returns
+        bool step(Scanner& scanner, ShareRecord& share) {
+            if (state_ == State::Open) {
+                scanner.expect('{');
+                if (scanner.consume('}')) {
+                    state_ = State::Done;
+                } else if (scanner.exhausted()) {
+                    scanner.fail("expected a member");  // may be an empty object split by the refill
+                } else {
+                    state_ = State::Members;
+                }
+                return false;
+            }
+            bool isShare = parseMember(scanner, header_, share);
+            if (!scanner.consume(',')) {
+                scanner.expect('}');
+                state_ = State::Done;
+            }
+            if (!header_.prime.empty()) {
+                prime_.assign(header_.prime.data(), header_.prime.size());
+                header_.prime = std::string_view();
+            }
+            return isShare;
+        }
+
+        void refill() {
+            size_t pending = end_ - begin_;
+            std::memmove(buffer_.data(), buffer_.data() + begin_, pending);
+            begin_ = 0;
+            end_ = pending;
+            if (end_ == buffer_.size()) {
+                buffer_.resize(buffer_.size() * 2);  // one entry fills the whole buffer
+            }
+            size_t count = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_.get());
+            if (count == 0) {
+                if (std::ferror(file_.get())) {
+                    throw std::runtime_error("Cannot read file: " + filename_);
+                }
+                eof_ = true;
+            }
+            end_ += count;
+        }
+
+        std::string filename_;
+        std::unique_ptr<std::FILE, FileCloser> file_;
+        std::vector<char> buffer_;
+        size_t begin_ = 0;   // first unconsumed byte in buffer_
+        size_t end_ = 0;     // end of the buffered text
+        size_t offset_ = 0;  // input offset of buffer_[begin_]
+        bool eof_ = false;
+        State state_ = State::Open;
+        Header header_;
+        std::string prime_;
+    };
+
+    // Inputs from this size on (and stdin) are read through ShareStream
+    static constexpr uint64_t kStreamingMinBytes = uint64_t(1) << 28;
+
+    static bool prefersStreaming(const std::string& filename) {
+        if (filename == "-") return true;
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        return file && static_cast<uint64_t>(file.tellg()) >= kStreamingMinBytes;
+    }
+};
+
+/**
+ * Polynomial Solver - Finds constant c using Lagrange interpolation
+ * 
+ * This program:
+ * 1. Reads JSON files containing encoded values in different bases
+ * 2. Decodes the y-values from their respective bases to decimal
+ * 3. Uses Lagrange interpolation to find the constant term at x=0
+ * 4. Uses the built-in BigInteger type (arbitrary precision, no external dependencies)
+ */
+class PolynomialSolver {
+public:
+    /**
+     * How the constant term is computed from the selected points
+     * Exact: integer numerators over a common denominator, one division at the end
+     * FloatApprox: long double accumulation (fast, loses precision past ~64 bits)
+     * MultiModular: exact integer result via residues mod many 62-bit primes + CRT
+     *               (assumes the points lie on an integer polynomial)
+     */
+    enum class InterpolationMode { Exact, FloatApprox, MultiModular };
+
+    // Per-point logging; disabled by the benchmarks
+    static inline bool verbose = true;
+
+    /**
+     * Pipeline counters, accumulated over every test case since start-up
+     * Shares are parsed eagerly but decoded only when the solver uses them, so
+     * decodes skipped = shares parsed - shares decoded.
+     */
+    struct StageCounters {
+        std::atomic<uint64_t> sharesParsed;
+        std::atomic<uint64_t> sharesDecoded;
+    };
+    static inline StageCounters stageCounters{};  // value-initialized: all zero
+
+    static void printStageCounters() {
+        uint64_t parsed = stageCounters.sharesParsed, decoded = stageCounters.sharesDecoded;
+        std::cout << "Stage counters: " << parsed << " shares parsed, " << decoded << " decoded, "
+                  << (parsed > decoded ? parsed - decoded : 0) << " decodes skipped" << std::endl;
+    }
+
+    // Values with at least this many digits are decoded by divide and conquer
+    // (default measured on the reference machine; --bench reports the crossover)
+    static inline size_t divideConquerDecodeThreshold = 2000;
+
+    // From this many points on, GF(p) interpolation over an NTT-friendly 64-bit
+    // prime uses the subproduct-tree engine (default measured on the reference
+    // machine; --bench reports the crossover)
+    static inline int fastInterpolationThreshold = 512;
+
+    /**
+     * Represents a single root point (x, y) where:
+     * x = the x-coordinate (input value)
+     * y = the y-coordinate (decoded from base-encoded string)
+     */
+    struct Root {
+        uint64_t x;     // x-coordinate (the index from JSON, as ShareTable stores it)
+        TieredValue y;  // y-coordinate (decoded from base-encoded value)
+        
+        Root(uint64_t x_val, TieredValue y_val) : x(x_val), y(std::move(y_val)) {}
+        Root(uint64_t x_val, const BigInt& y_val) : x(x_val), y(y_val) {}
+        
+        std::string toString() const {
+            return "(" + std::to_string(x) + ", " + y.toString() + ")";
+        }
+    };
+    
+    /**
+     * Container for a complete test case
+     * Holds the metadata (n, k) and the share table, sorted by x (move-only)
+     */
+    struct TestCase {
+        int n;              // Number of roots
+        int k;              // Parameter k
+        ShareTable shares;  // All shares; y-values are decoded as the solver needs them
+        BigInt prime;       // Field modulus for GF(p) shares (zero = integer shares)
+        
+        TestCase(int n_val, int k_val, ShareTable shares_val, BigInt prime_val = BigInt()) 
+            : n(n_val), k(k_val), shares(std::move(shares_val)), prime(prime_val) {}
+    };
+
+    /**
+     * Result class to hold the processed test case data
+     * Contains n, k, the share table, and calculated constant c
+     */
+    struct ProcessResult {
+        int n;              // Number of roots
+        int k;              // Parameter k from JSON
+        ShareTable shares;  // The decoded (x, y) coordinates
+        BigInt constantC;   // Calculated constant c
+        
+        ProcessResult(int n_val, int k_val, ShareTable shares_val, BigInt constantC_val)
+            : n(n_val), k(k_val), shares(std::move(shares_val)), constantC(constantC_val) {}
+    };
+
+    /**
+     * Result of robust (error-correcting) reconstruction over GF(p)
+     * Holds the constant and the x of every share that disagrees with the
+     * decoded polynomial.
+     */
+    struct RobustResult {
+        BigInt constantC;                // Calculated constant c
+        std::vector<uint64_t> badShares;  // x-coordinates of the corrupted shares
+    };
+
+    /**
+     * Result of consensus reconstruction over k-subsets of integer shares
+     */
+    struct ConsensusResult {
+        BigInt constantC;        // Value the most subsets agree on
+        uint64_t votes;          // Subsets that produced it
+        uint64_t runnerUpVotes;  // Subsets behind the next most common value
+        uint64_t evaluated;      // Subsets evaluated before the vote was decided
+        uint64_t subsets;        // C(n, k)
+    };
+
+    // Consensus refuses to enumerate more k-subsets than this (every distinct
+    // candidate value is kept in memory while voting)
+    static constexpr uint64_t kConsensusMaxSubsets = uint64_t(1) << 24;
+
+    /**
+     * Main entry point for processing a single test case file
+     */
+    static ProcessResult processTestCase(const std::string& filename) {
+        TestCase testCase = readTestCase(filename);
+        BigInt constantC = solvePolynomial(testCase);
+        return ProcessResult(testCase.n, testCase.k, std::move(testCase.shares), constantC);
+    }
+
+    /**
+     * processTestCase with error correction: every share is read and decoded
+     */
+    static RobustResult processRobust(const std::string& filename) {
+        TestCase testCase = readTestCase(filename, true);
+        return solveRobust(testCase);
+    }
+
+    /**
+     * processTestCase by k-subset voting: every share is read and decoded
+     */
+    static ConsensusResult processConsensus(const std::string& filename) {
+        TestCase testCase = readTestCase(filename, true);
+        return solveConsensus(testCase);
+    }
+
+    /**
+     * Batched reconstruction for many test cases
+     * Each case selects its shares (selectShares) and cases are then grouped by
+     * x-set signature (prime plus the selected x-coordinates);
+     * each group computes its Lagrange weights once and evaluates every constant
+     * as one dense weights x Y product. Results are returned in input order.
+     */
+    static std::vector<BigInt> solveBatch(std::vector<TestCase>& testCases) {
+        std::map<std::vector<BigInt>, std::vector<size_t>> groups;
+        std::vector<std::vector<size_t>> selections(testCases.size());
+        for (size_t c = 0; c < testCases.size(); c++) {
+            TestCase& testCase = testCases[c];
+            if (testCase.shares.empty()) {
+                throw std::invalid_argument("No roots provided");
+            }
+            int numPoints = std::min(testCase.k, static_cast<int>(testCase.shares.size()));
+            selections[c] = selectShares(testCase.shares, numPoints, testCase.prime);
+            decodeShares(testCase.shares, selections[c]);
+            std::vector<BigInt> signature{testCase.prime};
+            for (size_t position : selections[c]) {
+                signature.push_back(BigInt(testCase.shares.x(position)));
+            }
+            groups[signature].push_back(c);
+        }
+        
+        std::vector<BigInt> results(testCases.size());
+        for (const auto& group : groups) {
+            const BigInt& prime = group.first[0];
+            int numPoints = static_cast<int>(group.first.size()) - 1;
+            const std::vector<size_t>& members = group.second;
+            if (prime.isZero()) {
+                solveExactGroup(testCases, selections, members, numPoints, results);
+            } else if (prime.bitLength() <= 64) {
+                solveModularGroup(MontgomeryField64(prime.limb(0)), testCases, selections, members, numPoints, results);
+            } else if (prime.bitLength() <= 128) {
+                solveModularGroup(MontgomeryFieldN<2>(prime), testCases, selections, members, numPoints, results);
+            } else if (prime.bitLength() <= 256) {
+                solveModularGroup(MontgomeryFieldN<4>(prime), testCases, selections, members, numPoints, results);
+            } else if (prime.bitLength() <= 512) {
+                solveModularGroup(MontgomeryFieldN<8>(prime), testCases, selections, members, numPoints, results);
+            } else {
+                throw std::invalid_argument("Prime too large for GF(p) interpolation (max 512 bits): " +
+                                            prime.toString());
+            }
+        }
+        return results;
+    }
+
+    /**
+     * Reads every file and solves them together with solveBatch
+     */
+    static std::vector<BigInt> processBatch(const std::vector<std::string>& filenames) {
+        std::vector<TestCase> testCases;
+        for (const std::string& filename : filenames) {
+            testCases.push_back(readTestCase(filename));
+        }
+        return solveBatch(testCases);
+    }
+
+    /**
+     * Main method - runs both test cases automatically
+     */
+    static void runTests() {
+        try {
+            // Test case 1
+            std::cout << "=== Test Case 1 ===" << std::endl;
+            TestCase testCase1 = readTestCase("test_case_1.json");
+            std::cout << "Found " << testCase1.shares.size() << " roots:" << std::endl;
+            for (size_t i = 0; i < testCase1.shares.size(); ++i) {
+                std::cout << "  " << testCase1.shares.pointString(i) << std::endl;
+            }
+            
+            BigInt constantC1 = solvePolynomial(testCase1);
+            std::cout << "Constant c for test case 1: " << constantC1 << std::endl;
+            
+            std::cout << "\n=== Test Case 2 ===" << std::endl;
+            TestCase testCase2 = readTestCase("test_case_2.json");
+            std::cout << "Found " << testCase2.shares.size() << " roots:" << std::endl;
+            for (size_t i = 0; i < std::min(testCase2.shares.size(), size_t(5)); ++i) {
+                std::cout << "  " << testCase2.shares.pointString(i) << std::endl;
+            }
+            if (testCase2.shares.size() > 5) {
+                std::cout << "  ... and " << (testCase2.shares.size() - 5) << " more roots" << std::endl;
+            }
+            
+            BigInt constantC2 = solvePolynomial(testCase2);
+            std::cout << "Constant c for test case 2: " << constantC2 << std::endl;
+            
+            std::cout << std::endl;
+            printStageCounters();
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+        }
+    }
+
+    /**
+     * Benchmark mode - compares the exact and float interpolation paths as k grows
+     * Points are sampled from a random polynomial with 62-bit coefficients at x = 1..k.
+     */
+    static void runBenchmarks() {
+        bool previousVerbose = verbose;
+        verbose = false;
+        std::mt19937_64 rng(12345);
+        
+        std::cout << "=== Interpolation benchmark: exact vs float ===" << std::endl;
+        std::cout << std::setw(6) << "k" << std::setw(14) << "exact (us)" << std::setw(14) << "float (us)"
+                  << std::setw(10) << "float ok" << std::endl;
+        
+        for (int k : {3, 7, 10, 16, 24, 32, 48, 64}) {
+            std::vector<Root> roots = randomPolynomialRoots(k, rng);
+            BigInt expected = roots.back().y.toBigInt();  // constant term is stashed in the last entry
+            roots.pop_back();
+            
+            int repetitions = std::max(1, 20000 / (k * k));
+            BigInt exact, approx;
+            double exactMicros = timeMicros(repetitions, [&] {
+                exact = lagrangeExactAtZero(roots, k);
+            });
+            double floatMicros = timeMicros(repetitions, [&] {
+                approx = lagrangeFloatAtZero(roots, k);
+            });
+            if (exact != expected) {
+                throw std::runtime_error("Exact interpolation mismatch at k=" + std::to_string(k));
+            }
+            
+            std::cout << std::setw(6) << k << std::setw(14) << std::fixed << std::setprecision(2) << exactMicros
+                      << std::setw(14) << floatMicros << std::setw(10) << (approx == expected ? "yes" : "no")
+                      << std::endl;
+        }
+        
+        std::cout << "\n=== GF(p) interpolation benchmark (p = 2^61 - 1) ===" << std::endl;
+        std::cout << std::setw(8) << "k" << std::setw(14) << "time (ms)" << std::endl;
+        MontgomeryField64 field((uint64_t(1) << 61) - 1);
+        for (int k : {100, 1000, 4000}) {
+            std::vector<Root> roots;
+            for (int x = 1; x <= k; x++) {
+                roots.emplace_back(static_cast<uint64_t>(x), BigInt::fromUnsigned(rng() % field.modulus()));
+            }
+            double millis = timeMicros(1, [&] { lagrangeModularAtZero(field, roots, k); }) / 1000.0;
+            std::cout << std::setw(8) << k << std::setw(14) << millis << std::endl;
+        }
+        
+        std::cout << "\n=== Primality of GF(p) moduli (Baillie-PSW above 2^64) ===" << std::endl;
+        std::cout << std::setw(6) << "bits" << std::setw(10) << "prime" << std::setw(14) << "time (us)" << std::endl;
+        const std::pair<const char*, bool> moduli[] = {
+            {"4179340454199820289", true},
+            {"170141183460469231731687303715884105727", true},  // 2^127 - 1
+            {"318665857834031151167461", false},  // 399165290221 * 798330580441, passes Miller-Rabin to bases 2..37
+            {"3317044064679887385961981", false},  // strong pseudoprime to bases 2..37
+            {"57896044618658097711785492504343953926634992332820282019728792003956564819949", true},  // 2^255 - 19
+        };
+        for (const auto& entry : moduli) {
+            BigInt modulus = decodeFromBase(entry.first, "10");
+            bool prime = false;
+            double micros = timeMicros(20, [&] { prime = CrtToolkit::isPrime(modulus); });
+            if (prime != entry.second) {
+                throw std::runtime_error(std::string("Primality mismatch for ") + entry.first);
+            }
+            std::cout << std::setw(6) << modulus.bitLength() << std::setw(10) << (prime ? "yes" : "no")
+                      << std::setw(14) << micros << std::endl;
+        }
+        
+        std::cout << "\n=== GF(p) naive vs subproduct tree (p = 29 * 2^57 + 1) ===" << std::endl;
+        std::cout << std::setw(8) << "k" << std::setw(14) << "naive (ms)" << std::setw(14) << "fast (ms)" << std::endl;
+        MontgomeryField64 nttField(4179340454199820289ULL);
+        FieldPolynomials polys(nttField);
+        int crossover = -1;
+        for (int k : {64, 128, 256, 512, 1024, 2048, 4096, 8192}) {
+            std::vector<Root> roots;
+            for (int i = 0; i < k; i++) {
+                roots.emplace_back(rng() % nttField.modulus(), BigInt::fromUnsigned(rng() % nttField.modulus()));
+            }
+            BigInt naive, fast;
+            int repetitions = k <= 1024 ? 5 : 1;
+            double naiveMillis =
+                timeMicros(repetitions, [&] { naive = lagrangeModularAtZero(nttField, roots, k); }) / 1000.0;
+            double fastMillis = timeMicros(repetitions, [&] { fast = fastLagrangeAtZero(polys, roots, k); }) / 1000.0;
+            if (naive != fast) {
+                throw std::runtime_error("Fast interpolation mismatch at k=" + std::to_string(k));
+            }
+            // Crossover = first k from which the subproduct tree keeps winning
+            if (fastMillis >= naiveMillis) {
+                crossover = -1;
+            } else if (crossover < 0) {
+                crossover = k;
+            }
+            std::cout << std::setw(8) << k << std::setw(14) << naiveMillis << std::setw(14) << fastMillis << std::endl;
+        }
+        std::cout << "Measured crossover: k=" << crossover
+                  << " (fastInterpolationThreshold=" << fastInterpolationThreshold << ")" << std::endl;
+        
+        std::cout << "\n=== Reed-Solomon decoding, k = n/4 with floor((n-k)/2) bad shares (p = 29 * 2^57 + 1) ==="
+                  << std::endl;
+        std::cout << std::setw(8) << "n" << std::setw(10) << "errors" << std::setw(14) << "BW (us)"
+                  << std::setw(14) << "Gao (us)" << std::endl;
+        ReedSolomonDecoder<MontgomeryField64> decoder(polys);
+        size_t decoderCrossover = 0;
+        for (size_t n : {8, 12, 16, 24, 32, 48, 64, 128, 256, 1024, 4096, 16384}) {
+            const size_t k = n / 4, errors = ReedSolomonDecoder<MontgomeryField64>::capacity(n, k);
+            FieldPolynomials::Poly f(k);
+            for (auto& c : f) c = nttField.fromUint(rng());
+            std::vector<FieldPolynomials::Element> xs(n), ys(n);
+            for (size_t i = 0; i < n; i++) {
+                xs[i] = nttField.fromUint(i + 1);
+                ys[i] = polys.evaluate(f, xs[i]);
+            }
+            for (size_t i = 0; i < errors; i++) {
+                size_t position = (i * 7919) % n;
+                while (ys[position] != polys.evaluate(f, xs[position])) position = (position + 1) % n;
+                ys[position] = nttField.add(ys[position], nttField.one());
+            }
+            FieldPolynomials::Poly welch, gao;
+            int repetitions = n <= 64 ? 200 : 1;
+            double welchMicros = -1;
+            if (n <= 256) {
+                welchMicros = timeMicros(repetitions, [&] { decoder.berlekampWelch(xs, ys, k, welch); });
+                if (welch != f) throw std::runtime_error("Berlekamp-Welch mismatch at n=" + std::to_string(n));
+            }
+            double gaoMicros = timeMicros(repetitions, [&] { decoder.gao(xs, ys, k, gao); });
+            if (gao != f) throw std::runtime_error("Gao decoding mismatch at n=" + std::to_string(n));
+            // Crossover = first n from which Gao keeps winning
+            if (welchMicros >= 0) {
+                if (gaoMicros >= welchMicros) {
+                    decoderCrossover = 0;
+                } else if (decoderCrossover == 0) {
+                    decoderCrossover = n;
+                }
+            }
+            std::ostringstream welchText;
+            welchText.copyfmt(std::cout);
+            if (welchMicros < 0) {
+                welchText << "-";
+            } else {
+                welchText << welchMicros;
+            }
+            std::cout << std::setw(8) << n << std::setw(10) << errors << std::setw(14) << welchText.str()
+                      << std::setw(14) << gaoMicros << std::endl;
+        }
+        std::cout << "Measured crossover: n=" << decoderCrossover << " (kBerlekampWelchMaxShares="
+                  << ReedSolomonDecoder<MontgomeryField64>::kBerlekampWelchMaxShares << ")" << std::endl;
+        
+        std::cout << "\n=== Exact vs multi-modular CRT (2048-bit coefficients, random 40-bit x) ===" << std::endl;
+        std::cout << std::setw(6) << "k" << std::setw(14) << "exact (ms)" << std::setw(14) << "CRT (ms)" << std::endl;
+        for (int k : {8, 32, 128}) {
+            std::vector<BigInt> coefficients;
+            for (int i = 0; i < k; i++) {
+                BigInt coefficient = 0;
+                for (int limb = 0; limb < 32; limb++) coefficient = (coefficient << 64) + BigInt(rng());
+                coefficients.push_back(coefficient);
+            }
+            std::vector<Root> roots;
+            for (int i = 0; i < k; i++) {
+                uint64_t x = rng() >> 24;
+                BigInt y = 0;
+                for (int j = k - 1; j >= 0; j--) y = y * BigInt(x) + coefficients[j];
+                roots.emplace_back(x, y);
+            }
+            BigInt exact, crt;
+            double exactMillis = timeMicros(1, [&] { exact = lagrangeExactAtZero(roots, k); }) / 1000.0;
+            double crtMillis = timeMicros(1, [&] { crt = multiModularAtZero(roots, k); }) / 1000.0;
+            if (exact != coefficients[0] || crt != coefficients[0]) {
+                throw std::runtime_error("CRT interpolation mismatch at k=" + std::to_string(k));
+            }
+            std::cout << std::setw(6) << k << std::setw(14) << exactMillis << std::setw(14) << crtMillis << std::endl;
+        }
+        
+        std::cout << "\n=== decodeFromBase throughput (digit kernels: " << DigitKernels::instructionSet()
+                  << ") ===" << std::endl;
+        std::cout << std::setw(6) << "base" << std::setw(10) << "digits" << std::setw(14) << "time (us)"
+                  << std::setw(12) << "MB/s" << std::endl;
+        for (int base : {2, 3, 6, 10, 16, 32}) {
+            for (size_t length : {size_t(4096), size_t(65536)}) {
+                std::string digits(length, '0');
+                for (char& c : digits) c = "0123456789abcdefghijklmnopqrstuv"[rng() % base];
+                digits[0] = '1';
+                int repetitions = length > 10000 ? 3 : 50;
+                double micros = timeMicros(repetitions, [&] { decodeFromBase(digits, std::to_string(base)); });
+                std::cout << std::setw(6) << base << std::setw(10) << length << std::setw(14) << micros
+                          << std::setw(12) << (length / micros) << std::endl;
+            }
+        }
+        
+        std::cout << "\n=== Chunked Horner vs divide-and-conquer decoding (base 10) ===" << std::endl;
+        std::cout << std::setw(10) << "digits" << std::setw(14) << "Horner (us)" << std::setw(14) << "D&C (us)" << std::endl;
+        size_t savedThreshold = divideConquerDecodeThreshold;
+        size_t decodeCrossover = 0;
+        for (size_t length : {size_t(500), size_t(1000), size_t(2000), size_t(4000), size_t(8000),
+                              size_t(32000), size_t(128000)}) {
+            std::string digits(length, '0');
+            for (char& c : digits) c = static_cast<char>('0' + rng() % 10);
+            digits[0] = '7';
+            int repetitions = length > 10000 ? 2 : 20;
+            BigInt horner, divided;
+            divideConquerDecodeThreshold = SIZE_MAX;
+            double hornerMicros = timeMicros(repetitions, [&] { horner = decodeFromBase(digits, "10"); });
+            divideConquerDecodeThreshold = 0;
+            double dividedMicros = timeMicros(repetitions, [&] { divided = decodeFromBase(digits, "10"); });
+            if (horner != divided) {
+                throw std::runtime_error("Divide-and-conquer decode mismatch at " + std::to_string(length) + " digits");
+            }
+            // Crossover = first length from which divide and conquer keeps winning
+            if (dividedMicros >= hornerMicros) {
+                decodeCrossover = 0;
+            } else if (decodeCrossover == 0) {
+                decodeCrossover = length;
+            }
+            std::cout << std::setw(10) << length << std::setw(14) << hornerMicros << std::setw(14) << dividedMicros
+                      << std::endl;
+        }
+        divideConquerDecodeThreshold = savedThreshold;
+        std::cout << "Measured crossover: " << decodeCrossover << " digits (divideConquerDecodeThreshold="
+                  << divideConquerDecodeThreshold << ")" << std::endl;
+        
+        std::cout << "\n=== Decoding vs re-encoding (BigInt::toString(base)) ===" << std::endl;
+        std::cout << std::setw(6) << "base" << std::setw(10) << "digits" << std::setw(14) << "decode (us)"
+                  << std::setw(14) << "encode (us)" << std::endl;
+        for (int base : {7, 10, 36}) {
+            for (size_t length : {size_t(1000), size_t(10000), size_t(100000)}) {
+                std::string digits(length, '0');
+                for (char& c : digits) c = "0123456789abcdefghijklmnopqrstuvwxyz"[rng() % base];
+                digits[0] = '1';
+                int repetitions = length > 10000 ? 2 : 20;
+                // One untimed round trip first, so both sides run with warm power-tree caches
+                BigInt value = decodeFromBase(digits, std::to_string(base));
+                std::string encoded = value.toString(base);
+                double decodeMicros = timeMicros(repetitions, [&] { value = decodeFromBase(digits, std::to_string(base)); });
+                double encodeMicros = timeMicros(repetitions, [&] { encoded = value.toString(base); });
+                if (encoded != digits) {
+                    throw std::runtime_error("Base " + std::to_string(base) + " round trip mismatch at " +
+                                             std::to_string(length) + " digits");
+                }
+                std::cout << std::setw(6) << base << std::setw(10) << length << std::setw(14) << decodeMicros
+                          << std::setw(14) << encodeMicros << std::endl;
+            }
+        }
+        
+        std::cout << "\n=== JSON parsing throughput (stage 1: " << SimpleJsonParser::structuralInstructionSet()
+                  << ") ===" << std::endl;
+        std::cout << std::setw(10) << "shares" << std::setw(10) << "MB" << std::setw(16) << "scanner (GB/s)"
+                  << std::setw(16) << "stage 1 (GB/s)" << std::setw(18) << "two-stage (GB/s)" << std::endl;
+        std::string largest;
+        for (size_t shares : {size_t(1000), size_t(100000), size_t(300000)}) {
+            std::string json = "{\n  \"keys\": {\n    \"n\": " + std::to_string(shares) + ",\n    \"k\": 3\n  }";
+            for (size_t i = 1; i <= shares; i++) {
+                std::string digits(20 + rng() % 60, '0');
+                for (char& c : digits) c = "0123456789abcdef"[rng() % 16];
+                json += ",\n  \"" + std::to_string(i) + "\": {\n    \"base\": \"16\",\n    \"value\": \"" + digits + "\"\n  }";
+            }
+            json += "\n}\n";
+            int repetitions = shares >= 100000 ? 3 : 100;
+            SimpleJsonParser::Document scanned, indexed;
+            double scannerMicros = timeMicros(repetitions, [&] {
+                scanned.shares.clear();
+                SimpleJsonParser::parse(json, scanned);
+            });
+            double stageOneMicros = timeMicros(repetitions, [&] {
+                SimpleJsonParser::StructuralIndexer indexer(json);
+                std::vector<size_t> window(64 * SimpleJsonParser::kStructuralWindowBlocks);
+                while (!indexer.finished()) indexer.next(window.data(), SimpleJsonParser::kStructuralWindowBlocks);
+            });
+            double twoStageMicros = timeMicros(repetitions, [&] {
+                indexed.shares.clear();
+                SimpleJsonParser::parseIndexed(json, indexed);
+            });
+            if (scanned.shares.size() != shares || indexed.shares.size() != shares ||
+                indexed.shares.value(shares - 1) != scanned.shares.value(shares - 1)) {
+                throw std::runtime_error("Parsers disagree on a document with " + std::to_string(shares) + " shares");
+            }
+            // bytes per microsecond / 1000 = GB/s
+            std::cout << std::setw(10) << shares << std::setw(10) << json.size() / 1e6
+                      << std::setw(16) << json.size() / scannerMicros / 1000
+                      << std::setw(16) << json.size() / stageOneMicros / 1000
+                      << std::setw(18) << json.size() / twoStageMicros / 1000 << std::endl;
+            largest = std::move(json);
+        }
+        
+        // Same document from disk: mapped in place vs copied through istreambuf_iterator.
+        // The file lives in the temp directory and is removed even when a check throws.
+        const std::string benchFile =
+            (std::filesystem::temp_directory_path() / "polynomial_solver_bench.json").string();
+        struct FileRemover {
+            const std::string& path;
+            ~FileRemover() { std::remove(path.c_str()); }
+        } remover{benchFile};
+        std::ofstream(benchFile, std::ios::binary) << largest;
+        double mappedMicros = timeMicros(3, [&] {
+            if (SimpleJsonParser::parseTestCase(benchFile).shares.size() != 300000) {
+                throw std::runtime_error("Mapped parse lost shares");
+            }
+        });
+        double copiedMicros = timeMicros(3, [&] {
+            std::ifstream file(benchFile, std::ios::binary);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            SimpleJsonParser::Document document;
+            SimpleJsonParser::parseIndexed(content, document);
+        });
+        size_t streamBuffer = 0;
+        double streamedMicros = timeMicros(3, [&] {
+            SimpleJsonParser::ShareStream stream(benchFile, 64 * 1024);
+            SimpleJsonParser::ShareRecord share;
+            size_t count = 0;
+            while (stream.next(share)) count++;
+            if (count != 300000) {
+                throw std::runtime_error("Streaming parse lost shares");
+            }
+            streamBuffer = stream.bufferBytes();
+        });
+        std::cout << "From file (" << largest.size() / 1e6 << " MB): mmap " << mappedMicros << " us, istreambuf copy "
+                  << copiedMicros << " us, stream " << streamedMicros << " us (" << streamBuffer / 1024
+                  << " KiB buffer)" << std::endl;
+        
+        std::cout << "\n=== Batched reconstruction (k = 7, one shared x-set) ===" << std::endl;
+        std::cout << std::setw(10) << "mode" << std::setw(10) << "cases" << std::setw(16) << "per-case (ms)"
+                  << std::setw(14) << "batch (ms)" << std::endl;
+        for (bool modular : {true, false}) {
+            const int batchSize = modular ? 200000 : 20000;
+            const uint64_t xs[] = {2, 3, 5, 7, 11, 13, 17};
+            BigInt prime = modular ? BigInt::fromUnsigned((uint64_t(1) << 61) - 1) : BigInt();
+            std::vector<TestCase> testCases;
+            for (int c = 0; c < batchSize; c++) {
+                ShareTable shares;
+                for (uint64_t x : xs) {
+                    shares.add(x, BigInt::fromUnsigned(rng() >> 3));
+                }
+                testCases.emplace_back(7, 7, std::move(shares), prime);
+            }
+            std::vector<BigInt> single(batchSize), batched;
+            double singleMillis = timeMicros(1, [&] {
+                for (int c = 0; c < batchSize; c++) single[c] = solvePolynomial(testCases[c]);
+            }) / 1000.0;
+            double batchMillis = timeMicros(1, [&] { batched = solveBatch(testCases); }) / 1000.0;
+            if (single != batched) {
+                throw std::runtime_error("Batched reconstruction mismatch");
+            }
+            std::cout << std::setw(10) << (modular ? "GF(p)" : "exact") << std::setw(10) << batchSize
+                      << std::setw(16) << singleMillis << std::setw(14) << batchMillis << std::endl;
+        }
+        
+        std::cout << "\n=== k-subset consensus (integer shares at x = 1..n, 3 of them wrong) ===" << std::endl;
+        std::cout << std::setw(6) << "n" << std::setw(6) << "k" << std::setw(12) << "subsets" << std::setw(12)
+                  << "evaluated" << std::setw(10) << "votes" << std::setw(12) << "time (ms)" << std::endl;
+        for (auto [n, k] : {std::pair<int, int>{12, 6}, {16, 8}, {20, 10}, {24, 8}}) {
+            std::vector<BigInt> coefficients;
+            for (int i = 0; i < k; i++) coefficients.push_back(BigInt::fromUnsigned(rng() >> 2));
+            ShareTable shares;
+            for (int x = 1; x <= n; x++) {
+                BigInt y;
+                for (int i = k - 1; i >= 0; i--) y = y * BigInt(x) + coefficients[i];
+                if (x % 5 == 2 && x < 16) y += BigInt(1);
+                shares.add(static_cast<uint64_t>(x), y);
+            }
+            TestCase testCase(n, k, std::move(shares));
+            ConsensusResult result{};
+            double millis = timeMicros(1, [&] { result = solveConsensus(testCase); }) / 1000.0;
+            if (result.constantC != coefficients[0]) {
+                throw std::runtime_error("Consensus mismatch at n=" + std::to_string(n));
+            }
+            std::cout << std::setw(6) << n << std::setw(6) << k << std::setw(12) << result.subsets << std::setw(12)
+                      << result.evaluated << std::setw(10) << result.votes << std::setw(12) << millis << std::endl;
+        }
+        
+        calibrateMultiplication(rng);
+        
+        verbose = previousVerbose;
+    }
+
+private:
+    /**
+     * Multiplication calibration: times the top-level algorithm on either side of
+     * BigInt::toomThreshold and BigInt::nttThreshold (with the tuned algorithms
+     * underneath) and reports where the faster one starts winning for good;
+     * the thresholds are left as they were
+     */
+    static void calibrateMultiplication(std::mt19937_64& rng) {
+        struct Stage {
+            const char* title;
+            size_t* threshold;
+            std::vector<size_t> sizes;
+        };
+        const Stage stages[] = {
+            {"Karatsuba vs Toom-3", &BigInt::toomThreshold, {64, 96, 128, 160, 192, 256, 384, 512, 768}},
+            {"Toom-3 vs NTT", &BigInt::nttThreshold, {512, 768, 1024, 1536, 2048, 3072, 4096, 8192, 16384}},
+        };
+        for (const Stage& stage : stages) {
+            std::cout << "\n=== Multiplication calibration: " << stage.title << " ===" << std::endl;
+            std::cout << std::setw(10) << "limbs" << std::setw(14) << "below (us)" << std::setw(14) << "above (us)"
+                      << std::endl;
+            size_t savedThreshold = *stage.threshold;
+            size_t crossover = 0;
+            for (size_t limbs : stage.sizes) {
+                std::vector<uint64_t> a(limbs), b(limbs);
+                for (size_t i = 0; i < limbs; i++) {
+                    a[i] = rng();
+                    b[i] = rng();
+                }
+                BigInt left = BigInt::fromLimbs(a.data(), limbs), right = BigInt::fromLimbs(b.data(), limbs);
+                int repetitions = static_cast<int>(std::max<size_t>(2, 200000 / limbs / limbs * 64));
+                BigInt below, above;
+                *stage.threshold = SIZE_MAX;
+                double belowMicros = timeMicros(repetitions, [&] { below = left * right; });
+                *stage.threshold = limbs;
+                double aboveMicros = timeMicros(repetitions, [&] { above = left * right; });
+                *stage.threshold = savedThreshold;
+                if (below != above) {
+                    throw std::runtime_error(std::string(stage.title) + " mismatch at " + std::to_string(limbs) + " limbs");
+                }
+                if (aboveMicros >= belowMicros) {
+                    crossover = 0;
+                } else if (crossover == 0) {
+                    crossover = limbs;
+                }
+                std::cout << std::setw(10) << limbs << std::setw(14) << belowMicros << std::setw(14) << aboveMicros
+                          << std::endl;
+            }
+            std::cout << "Measured crossover: " << crossover << " limbs (current threshold " << savedThreshold << ")"
+                      << std::endl;
+        }
+    }
+
+    /**
+     * Exact constants for one x-set group: Σ W_i * y_i / D per case
+     */
+    static void solveExactGroup(const std::vector<TestCase>& testCases,
+                                const std::vector<std::vector<size_t>>& selections,
+                                const std::vector<size_t>& members, int numPoints, std::vector<BigInt>& results) {
+        const std::vector<Root> reference = selectedRoots(testCases[members[0]].shares, selections[members[0]]);
+        ExactWeights weights;
+        if (ConsecutiveWeights::isConsecutiveFromOne(reference, numPoints)) {
+            weights = ExactWeights{ConsecutiveWeights::exact(numPoints), BigInt(1)};
+        } else {
+            weights = exactLagrangeWeights(reference, numPoints);
+        }
+        bool integral = weights.denominator == BigInt(1);
+        for (size_t member : members) {
+            BigInt numerator = dotProduct(selectedRoots(testCases[member].shares, selections[member]),
+                                          weights.numerators, numPoints);
+            results[member] = integral ? numerator : divideRounded(numerator, weights.denominator);
+        }
+    }
+
+    /**
+     * GF(p) constants for one x-set group as a weights x Y product
+     * Y is stored point-major (row i holds y_i of every case in the group), so the
+     * inner loop streams contiguously across the batch with a loop-invariant weight.
+     */
+    template <typename Field>
+    static void solveModularGroup(const Field& field, const std::vector<TestCase>& testCases,
+                                  const std::vector<std::vector<size_t>>& selections,
+                                  const std::vector<size_t>& members, int numPoints, std::vector<BigInt>& results) {
+        using Element = typename Field::Element;
+        const std::vector<Root> reference = selectedRoots(testCases[members[0]].shares, selections[members[0]]);
+        std::vector<Element> weights;
+        if (ConsecutiveWeights::isConsecutiveFromOne(reference, numPoints) &&
+            BigInt(field.modulus()) > BigInt(numPoints)) {
+            weights = ConsecutiveWeights::modular(field, numPoints);
+        } else {
+            weights = modularLagrangeWeights(field, reference, numPoints);
+        }
+        
+        size_t batch = members.size();
+        std::vector<Element> ys(static_cast<size_t>(numPoints) * batch);
+        for (size_t c = 0; c < batch; c++) {
+            const ShareTable& shares = testCases[members[c]].shares;
+            const std::vector<size_t>& selected = selections[members[c]];
+            for (int i = 0; i < numPoints; i++) {
+                ys[static_cast<size_t>(i) * batch + c] = fieldValue(field, shares.y(selected[i]));
+            }
+        }
+        
+        std::vector<Element> constants(batch, field.zero());
+        for (int i = 0; i < numPoints; i++) {
+            const Element weight = weights[i];
+            const Element* row = ys.data() + static_cast<size_t>(i) * batch;
+            for (size_t c = 0; c < batch; c++) {
+                constants[c] = field.add(constants[c], field.mul(row[c], weight));
+            }
+        }
+        
+        for (size_t c = 0; c < batch; c++) {
+            results[members[c]] = field.toBigInt(constants[c]);
+        }
+    }
+
+    /**
+     * Samples k points (x = 1..k) of a random degree k-1 polynomial
+     * The polynomial's constant term is appended as an extra Root(0, c).
+     */
+    static std::vector<Root> randomPolynomialRoots(int k, std::mt19937_64& rng) {
+        std::vector<BigInt> coefficients;
+        for (int i = 0; i < k; i++) {
+            coefficients.push_back(BigInt::fromUnsigned(rng() >> 2));
+        }
+        std::vector<Root> roots;
+        for (int x = 1; x <= k; x++) {
+            BigInt y = 0;
+            for (int i = k - 1; i >= 0; i--) {
+                y = y * BigInt(x) + coefficients[i];
+            }
+            roots.emplace_back(static_cast<uint64_t>(x), y);
+        }
+        roots.emplace_back(uint64_t(0), coefficients[0]);
+        return roots;
+    }
+
+    // Average wall time per call in microseconds
+    template <typename Fn>
+    static double timeMicros(int repetitions, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++) {
+            fn();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() / repetitions;
+    }
+
+    /**
+     * Reads and parses a JSON test case file with the single-pass tokenizer
+     * 
+     * JSON Structure:
+     * {
+     *   "keys": {"n": 4, "k": 3},
+     *   "1": {"base": "10", "value": "4"},
+     *   "2": {"base": "2", "value": "111"},
+     *   ...
+     * }
+     * Large files and stdin are streamed (readStreamedTestCase) unless allShares
+     * asks for every share to be kept.
+     */
+    static TestCase readTestCase(const std::string& filename, bool allShares = false) {
+        if (!allShares && SimpleJsonParser::prefersStreaming(filename)) {
+            return readStreamedTestCase(filename);
+        }
+        
+        // Tokenize the JSON file straight into a share table
+        SimpleJsonParser::Document document = SimpleJsonParser::parseTestCase(filename);
+        
+        // Extract metadata from parsed data
+        int n = document.n;  // Number of roots
+        int k = document.k;  // Parameter k
+        
+        std::cout << "Parsing test case: n=" << n << ", k=" << k << std::endl;
+        
+        // Shares in x order, whatever order (and gaps, like index 6 in
+        // test_case_1.json) the file has; the share index is the x-coordinate
+        ShareTable& shares = document.shares;
+        shares.sortByX();
+        size_t duplicate = shares.findDuplicateX();
+        if (duplicate != shares.size()) {
+            throw std::invalid_argument("Duplicate share index: " + std::to_string(shares.x(duplicate)));
+        }
+        
+        // Values stay undecoded slices of the input until the solver picks its shares
+        stageCounters.sharesParsed += shares.size();
+        std::cout << "Successfully parsed " << shares.size() << " roots" << std::endl;
+        
+        BigInt prime;
+        if (!document.prime.empty()) {
+            prime = parsePrime(document.prime);
+            std::cout << "Shares are over GF(p) with p=" << prime << std::endl;
+        }
+        return TestCase(n, k, std::move(shares), prime);
+    }
+    
+    /**
+     * readTestCase for stdin and very large files, read through ShareStream
+     * Memory stays bounded however many shares the file holds: a share is kept
+     * (undecoded, its digits copied) only while it is among the k cheapest by
+     * selectionCost, under the exact and the modular key alike since "prime" may
+     * come last, or has x <= k. That is every share selectShares can pick, so
+     * solvePolynomial chooses as it would from the whole file, except that over a
+     * word-sized prime below some indices, x colliding mod p can push the choice
+     * past the k cheapest. Shares that precede "keys" are all kept until k is known.
+     * Duplicate indices are only caught among the kept shares.
+     */
+    static TestCase readStreamedTestCase(const std::string& filename) {
+        SimpleJsonParser::ShareStream stream(filename);
+        struct Kept {
+            int base;
+            std::string digits;
+            int holders;  // heaps and x <= k holding the share; dropped at zero
+        };
+        std::map<uint64_t, Kept> kept;
+        using Ranked = std::pair<double, uint64_t>;  // (cost, x), ties going to the lower x
+        std::vector<Ranked> cheapestExact, cheapestModular;  // max-heaps once k is known
+        size_t limit = 0;
+        
+        auto release = [&](uint64_t x) {
+            auto entry = kept.find(x);
+            if (--entry->second.holders == 0) kept.erase(entry);
+        };
+        auto offer = [&](std::vector<Ranked>& heap, Ranked candidate) {
+            if (heap.size() < limit) {
+                heap.push_back(candidate);
+            } else if (limit > 0 && candidate < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                release(heap.back().second);
+                heap.back() = candidate;
+            } else {
+                return;
+            }
+            std::push_heap(heap.begin(), heap.end());
+            kept[candidate.second].holders++;
+        };
+        // Hands a kept share to whichever of the two heaps and x <= k want it
+        auto rank = [&](uint64_t x, Kept& share) {
+            double bits = static_cast<double>(share.digits.size()) * std::log2(static_cast<double>(share.base));
+            share.holders = 1;  // held while it is being offered
+            if (x >= 1 && x <= limit) share.holders++;
+            offer(cheapestExact, {selectionCost(bits, false, x, limit, false), x});
+            offer(cheapestModular, {selectionCost(bits, false, x, limit, true), x});
+            release(x);
+        };
+        
+        // Once k is known, the shares kept so far go through the same ranking
+        bool bounded = false;
+        auto bound = [&] {
+            bounded = true;
+            limit = static_cast<size_t>(std::max(stream.k(), 0));
+            std::vector<uint64_t> pending;
+            for (const auto& entry : kept) pending.push_back(entry.first);
+            for (uint64_t x : pending) rank(x, kept.at(x));
+        };
+        
+        size_t streamed = 0;
+        SimpleJsonParser::ShareRecord share;
+        while (stream.next(share)) {
+            streamed++;
+            if (!bounded && stream.hasKeys()) bound();
+            if (kept.count(share.index) != 0) {
+                throw std::invalid_argument("Duplicate share index: " + std::to_string(share.index));
+            }
+            
+            // The buffer is recycled behind the stream, so kept digits are copied
+            Kept& entry = kept[share.index];
+            entry.base = share.base;
+            entry.digits.assign(share.value.data(), share.value.size());
+            entry.holders = 1;
+            if (bounded) rank(share.index, entry);
+        }
+        if (!bounded) bound();
+        
+        // The kept digits become the text of an undecoded table, in x order
+        std::vector<char> text;
+        for (const auto& entry : kept) text.insert(text.end(), entry.second.digits.begin(), entry.second.digits.end());
+        ShareTable shares(InputBuffer::fromBytes(std::move(text)));
+        size_t offset = 0;
+        for (const auto& entry : kept) {
+            shares.add(entry.first, entry.second.base, shares.text().substr(offset, entry.second.digits.size()));
+            offset += entry.second.digits.size();
+        }
+        stageCounters.sharesParsed += streamed;
+        std::cout << "Streamed " << streamed << " shares (" << stream.bufferBytes() / 1024
+                  << " KiB buffer), kept " << shares.size() << " roots" << std::endl;
+        
+        BigInt prime;
+        if (!stream.prime().empty()) {
+            prime = parsePrime(stream.prime());
+            std::cout << "Shares are over GF(p) with p=" << prime << std::endl;
+        }
+        return TestCase(stream.n(), stream.k(), std::move(shares), prime);
+    }
+    
+    /**
+     * The "prime" member as a BigInt; the field inverses use Fermat's little
+     * theorem, so a composite modulus would silently give a wrong secret
+     */
+    static BigInt parsePrime(std::string_view text) {
+        BigInt prime = decodeFromBase(text, "10");
+        if (!CrtToolkit::isPrime(prime)) {
+            throw std::invalid_argument("Modulus is not prime: " + prime.toString());
+        }
+        return prime;
+    }
+    
+    /**
+     * Main polynomial solving logic using Lagrange interpolation
+     * 
+     * Strategy:
+     * Use Lagrange interpolation to find the constant term at x=0
+     */
+    static BigInt solvePolynomial(TestCase& testCase,
+                                  InterpolationMode mode = InterpolationMode::Exact) {
+        ShareTable& shares = testCase.shares;
+        
+        if (shares.empty()) {
+            throw std::invalid_argument("No roots provided");
+        }
+        
+        if (verbose) {
+            std::cout << "Solving polynomial with " << shares.size() << " roots" << std::endl;
+            std::cout << "Using k=" << testCase.k << " points for interpolation" << std::endl;
+        }
+        
+        // Use exactly k points for Lagrange interpolation, chosen before anything
+        // is decoded; only those are decoded
+        int numPoints = std::min(testCase.k, static_cast<int>(shares.size()));
+        std::vector<size_t> selected = selectShares(shares, numPoints, testCase.prime);
+        if (verbose) {
+            std::cout << "Selected x =";
+            for (size_t i = 0; i < selected.size() && i < 16; i++) std::cout << " " << shares.x(selected[i]);
+            std::cout << (selected.size() > 16 ? " ..." : "") << std::endl;
+        }
+        decodeShares(shares, selected);
+        std::vector<Root> roots = selectedRoots(shares, selected);
+        
+        if (!testCase.prime.isZero()) {
+            return lagrangeInterpolationModP(testCase.prime, roots, numPoints);
+        }
+        return lagrangeInterpolationAtZero(roots, numPoints, mode);
+    }
+    
+    /**
+     * Robust reconstruction over GF(p): all n shares are Reed-Solomon decoded,
+     * so up to floor((n - k) / 2) wrong shares are corrected and reported
+     * (solvePolynomial trusts the k shares it selects). Berlekamp-Welch handles
+     * small n, Gao's decoder with a half-GCD extended Euclid large n.
+     */
+    static RobustResult solveRobust(TestCase& testCase) {
+        ShareTable& shares = testCase.shares;
+        const BigInt& prime = testCase.prime;
+        
+        if (shares.empty()) {
+            throw std::invalid_argument("No roots provided");
+        }
+        if (prime.isZero()) {
+            throw std::invalid_argument("Robust reconstruction needs shares over GF(p) (a \"prime\" member)");
+        }
+        if (testCase.k < 1 || shares.size() < static_cast<size_t>(testCase.k)) {
+            throw std::invalid_argument("Robust reconstruction needs at least k=" + std::to_string(testCase.k) +
+                                        " shares, got " + std::to_string(shares.size()));
+        }
+        
+        if (verbose) {
+            std::cout << "Decoding " << shares.size() << " shares with k=" << testCase.k << ", correcting up to "
+                      << (shares.size() - testCase.k) / 2 << " errors" << std::endl;
+        }
+        std::vector<size_t> all(shares.size());
+        for (size_t i = 0; i < all.size(); i++) all[i] = i;
+        decodeShares(shares, all);
+        
+        size_t bits = prime.bitLength();
+        if (bits <= 64) {
+            // Larger x-coordinates may coincide mod p (the table is sorted by x)
+            if (shares.x(shares.size() - 1) >= prime.limb(0)) {
+                std::vector<uint64_t> residues(shares.size());
+                for (size_t i = 0; i < shares.size(); i++) residues[i] = shares.x(i) % prime.limb(0);
+                std::sort(residues.begin(), residues.end());
+                if (std::adjacent_find(residues.begin(), residues.end()) != residues.end()) {
+                    throw std::invalid_argument("Shares with the same x mod p");
+                }
+            }
+            return robustModularDecode(MontgomeryField64(prime.limb(0)), shares, testCase.k);
+        } else if (bits <= 128) {
+            return robustModularDecode(MontgomeryFieldN<2>(prime), shares, testCase.k);
+        } else if (bits <= 256) {
+            return robustModularDecode(MontgomeryFieldN<4>(prime), shares, testCase.k);
+        } else if (bits <= 512) {
+            return robustModularDecode(MontgomeryFieldN<8>(prime), shares, testCase.k);
+        }
+        throw std::invalid_argument("Prime too large for GF(p) interpolation (max 512 bits): " + prime.toString());
+    }
+    
+    template <typename Field>
+    static RobustResult robustModularDecode(const Field& field, const ShareTable& shares, int k) {
+        using Element = typename Field::Element;
+        PolynomialRing<Field> polys(field);
+        ReedSolomonDecoder<Field> decoder(polys);
+        std::vector<Element> xs(shares.size()), ys(shares.size());
+        for (size_t i = 0; i < shares.size(); i++) {
+            xs[i] = field.fromUint(shares.x(i));
+            ys[i] = fieldValue(field, shares.y(i));
+        }
+        
+        typename ReedSolomonDecoder<Field>::Poly message;
+        std::vector<size_t> errors;
+        if (!decoder.decode(xs, ys, static_cast<size_t>(k), message, errors)) {
+            throw std::runtime_error("Too many corrupted shares: " + std::to_string(shares.size()) +
+                                     " shares with k=" + std::to_string(k) + " correct at most " +
+                                     std::to_string(ReedSolomonDecoder<Field>::capacity(shares.size(), static_cast<size_t>(k))));
+        }
+        RobustResult result;
+        result.constantC = message.empty() ? BigInt() : field.toBigInt(message[0]);
+        for (size_t i : errors) result.badShares.push_back(shares.x(i));
+        
+        if (verbose) {
+            std::cout << (shares.size() <= ReedSolomonDecoder<Field>::kBerlekampWelchMaxShares ? "Berlekamp-Welch"
+                                                                                              : "Gao")
+                      << " decoding found " << errors.size() << " bad shares" << std::endl;
+            for (size_t i : errors) std::cout << "  Bad share: " << shares.pointString(i) << std::endl;
+        }
+        return result;
+    }
+    
+    /**
+     * Consensus reconstruction for integer shares, some of which may be wrong
+     * Every k-subset of the n shares interpolates a candidate constant and votes
+     * for it. Voting stops once the leader is ahead of the runner-up by more than
+     * the subsets still to come, so no outcome of the rest can change the winner.
+     * Candidates are compared by their residues mod two 62-bit CRT primes, with
+     * the Lagrange weights carried from subset to subset in revolving-door order
+     * (one share leaves, one enters: O(k) per subset instead of O(k²)). Chunks of
+     * that order are spread over worker threads; the winner is finally
+     * recomputed exactly from one of its subsets.
+     */
+    static ConsensusResult solveConsensus(TestCase& testCase) {
+        using Element = MontgomeryField64::Element;
+        using Fingerprint = std::pair<uint64_t, uint64_t>;
+        ShareTable& shares = testCase.shares;
+        
+        if (shares.empty()) {
+            throw std::invalid_argument("No roots provided");
+        }
+        if (!testCase.prime.isZero()) {
+            throw std::invalid_argument("Consensus mode is for integer shares; GF(p) shares are decoded by --robust");
+        }
+        const size_t n = shares.size();
+        if (testCase.k < 1 || n < static_cast<size_t>(testCase.k)) {
+            throw std::invalid_argument("Consensus needs at least k=" + std::to_string(testCase.k) +
+                                        " shares, got " + std::to_string(n));
+        }
+        const size_t k = static_cast<size_t>(testCase.k);
+        const uint64_t subsets = RevolvingDoor::binomial(n, k);
+        if (subsets > kConsensusMaxSubsets) {
+            throw std::invalid_argument("Too many subsets for consensus: C(" + std::to_string(n) + ", " +
+                                        std::to_string(k) + ") exceeds " + std::to_string(kConsensusMaxSubsets));
+        }
+        if (shares.x(0) == 0) {
+            throw std::invalid_argument("Consensus mode needs non-zero x-coordinates");
+        }
+        std::vector<size_t> all(n);
+        for (size_t i = 0; i < n; i++) all[i] = i;
+        decodeShares(shares, all);
+        
+        // Two fingerprint primes under which every x stays non-zero and distinct
+        std::vector<ConsensusField> fields;
+        for (size_t count = 1; fields.size() < 2; count++) {
+            uint64_t prime = CrtToolkit::primes(count).back();
+            std::vector<uint64_t> residues(n);
+            for (size_t i = 0; i < n; i++) residues[i] = shares.x(i) % prime;
+            std::sort(residues.begin(), residues.end());
+            if (residues[0] == 0 || std::adjacent_find(residues.begin(), residues.end()) != residues.end()) continue;
+            ConsensusField lane{MontgomeryField64(prime), {}, {}, {}, {}};
+            for (size_t i = 0; i < n; i++) {
+                lane.xs.push_back(lane.field.fromUint(shares.x(i)));
+                lane.ys.push_back(fieldValue(lane.field, shares.y(i)));
+            }
+            lane.inverseXs = lane.xs;
+            batchInvert(lane.field, lane.inverseXs);
+            if (n <= kConsensusTableShares) {
+                lane.inverseDifferences.resize(n * n);
+                for (size_t b = 0; b < n; b++) {
+                    Element* row = lane.inverseDifferences.data() + b * n;
+                    for (size_t i = 0; i < n; i++) row[i] = i == b ? lane.field.one() : lane.field.sub(lane.xs[b], lane.xs[i]);
+                    std::vector<Element> inverted(row, row + n);
+                    batchInvert(lane.field, inverted);
+                    std::copy(inverted.begin(), inverted.end(), row);
+                }
+            }
+            fields.push_back(std::move(lane));
+        }
+        
+        size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+        const uint64_t chunkSize = std::min<uint64_t>(std::max<uint64_t>(subsets / (threadCount * 64), 256), 65536);
+        const uint64_t chunks = (subsets + chunkSize - 1) / chunkSize;
+        threadCount = static_cast<size_t>(std::min<uint64_t>(threadCount, chunks));
+        if (verbose) {
+            std::cout << "Consensus over C(" << n << ", " << k << ") = " << subsets << " subsets on " << threadCount
+                      << " threads" << std::endl;
+        }
+        
+        struct Tally {
+            uint64_t votes = 0;
+            uint64_t firstRank = UINT64_MAX;  // a subset that produced the value
+        };
+        std::map<Fingerprint, Tally> tallies;
+        Fingerprint leader{};
+        uint64_t leaderVotes = 0, runnerUpVotes = 0, evaluated = 0;
+        std::mutex tallyMutex;
+        std::atomic<uint64_t> nextChunk(0);
+        std::atomic<bool> decided(false);
+        
+        auto worker = [&] {
+            RevolvingDoor door(n, k);
+            std::vector<size_t> members(k), slotOf(n);
+            std::vector<std::vector<Element>> weights(fields.size(), std::vector<Element>(k));
+            std::vector<Element> inverses(k);
+            std::vector<std::pair<Fingerprint, uint64_t>> candidates;  // (value, rank)
+            for (uint64_t chunk = nextChunk++; chunk < chunks && !decided; chunk = nextChunk++) {
+                const uint64_t first = chunk * chunkSize, last = std::min(subsets, first + chunkSize);
+                door.seek(first);
+                for (size_t slot = 0; slot < k; slot++) {
+                    members[slot] = door[slot];
+                    slotOf[members[slot]] = slot;
+                }
+                for (size_t f = 0; f < fields.size(); f++) consensusWeights(fields[f], members, weights[f]);
+                candidates.clear();
+                for (uint64_t rank = first; rank < last; rank++) {
+                    if (rank > first) {
+                        size_t removed = 0, added = 0;
+                        door.next(removed, added);
+                        size_t slot = slotOf[removed];
+                        members[slot] = added;
+                        slotOf[added] = slot;
+                        for (size_t f = 0; f < fields.size(); f++) {
+                            swapConsensusWeight(fields[f], members, slot, removed, weights[f], inverses);
+                        }
+                    }
+                    candidates.emplace_back(Fingerprint(consensusValue(fields[0], members, weights[0]),
+                                                        consensusValue(fields[1], members, weights[1])),
+                                            rank);
+                }
+                std::sort(candidates.begin(), candidates.end());
+                
+                std::lock_guard<std::mutex> lock(tallyMutex);
+                for (size_t i = 0; i < candidates.size();) {
+                    size_t end = i;
+                    while (end < candidates.size() && candidates[end].first == candidates[i].first) end++;
+                    Tally& tally = tallies[candidates[i].first];
+                    tally.votes += end - i;
+                    tally.firstRank = std::min(tally.firstRank, candidates[i].second);
+                    // Votes only grow, so the leader and runner-up can be tracked incrementally
+                    if (candidates[i].first == leader) {
+                        leaderVotes = tally.votes;
+                    } else if (tally.votes > leaderVotes) {
+                        runnerUpVotes = leaderVotes;
+                        leader = candidates[i].first;
+                        leaderVotes = tally.votes;
+                    } else {
+                        runnerUpVotes = std::max(runnerUpVotes, tally.votes);
+                    }
+                    i = end;
+                }
+                evaluated += last - first;
+                if (leaderVotes > runnerUpVotes + (subsets - evaluated)) decided = true;
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < threadCount; t++) threads.emplace_back(worker);
+        worker();
+        for (std::thread& thread : threads) thread.join();
+        
+        if (leaderVotes == runnerUpVotes) {
+            throw std::runtime_error("No consensus: the two most common values each come from " +
+                                     std::to_string(leaderVotes) + " of " + std::to_string(subsets) + " subsets");
+        }
+        RevolvingDoor door(n, k);
+        door.seek(tallies[leader].firstRank);
+        std::vector<size_t> winning(k);
+        for (size_t slot = 0; slot < k; slot++) winning[slot] = door[slot];
+        std::vector<Root> roots = selectedRoots(shares, winning);
+        BigInt constantC = lagrangeInterpolationAtZero(roots, testCase.k);
+        if (verbose) {
+            std::cout << "Consensus after " << evaluated << " of " << subsets << " subsets: " << leaderVotes
+                      << " votes for " << constantC << " (runner-up " << runnerUpVotes << ")" << std::endl;
+        }
+        return ConsensusResult{constantC, leaderVotes, runnerUpVotes, evaluated, subsets};
+    }
+    
+    /**
+     * selectShares' score for one share of a `count`-share selection (see there)
+     */
+    static double selectionCost(double bits, bool decoded, uint64_t x, size_t count, bool modular) {
+        double cost = (decoded ? 0.0 : bits) + bits;
+        if (!modular) cost += static_cast<double>(count) * std::log2(static_cast<double>(x) + 1.0);
+        return cost;
+    }
+    
+    /**
+     * Selection stage: which `count` shares to interpolate through, decided from
+     * digit counts and x-coordinates alone, before anything is decoded
+     * Each share gets a coarse cost in bits of work: decoding (digits * log2(base),
+     * nothing once decoded) plus reducing or multiplying y (its bit size), and in
+     * exact mode count * log2(x), since every x enters all count Lagrange weights.
+     * The cheapest shares by that score are compared with x = 1..count, whose
+     * weights are cached binomials; the cheaper set wins, ties going to 1..count.
+     * Over GF(p) the generic set also pays for computing its weights, and shares
+     * whose x collides with a selected one mod p are passed over.
+     * Expects a table sorted by distinct x; returns positions in x order.
+     */
+    static std::vector<size_t> selectShares(const ShareTable& shares, int count, const BigInt& prime) {
+        const size_t n = shares.size();
+        const size_t k = static_cast<size_t>(std::max(count, 0));
+        const bool modular = !prime.isZero();
+        if (k >= n) {
+            std::vector<size_t> all(n);
+            for (size_t i = 0; i < n; i++) all[i] = i;
+            return all;
+        }
+        std::vector<double> cost(n);
+        for (size_t i = 0; i < n; i++) {
+            cost[i] = selectionCost(shares.estimatedBits(i), shares.isDecoded(i), shares.x(i), k, modular);
+        }
+        
+        // Cheapest by score; over a word-sized prime, x must also stay distinct mod p
+        std::vector<size_t> ranked(n);
+        for (size_t i = 0; i < n; i++) ranked[i] = i;
+        std::stable_sort(ranked.begin(), ranked.end(), [&](size_t a, size_t b) { return cost[a] < cost[b]; });
+        std::vector<size_t> cheapest;
+        std::vector<uint64_t> residues;
+        const bool wordPrime = modular && prime.bitLength() <= 64 && n > 0 && shares.x(n - 1) >= prime.limb(0);
+        for (size_t i = 0; i < n && cheapest.size() < k; i++) {
+            if (wordPrime) {
+                uint64_t residue = shares.x(ranked[i]) % prime.limb(0);
+                if (std::find(residues.begin(), residues.end(), residue) != residues.end()) continue;
+                residues.push_back(residue);
+            }
+            cheapest.push_back(ranked[i]);
+        }
+        if (cheapest.size() < k) {
+            throw std::invalid_argument("Not enough shares with distinct x mod p: need " + std::to_string(k));
+        }
+        std::sort(cheapest.begin(), cheapest.end());
+        double cheapestCost = 0;
+        for (size_t position : cheapest) cheapestCost += cost[position];
+        
+        // x = 1..k sits at the front of the sorted table when present
+        bool consecutive = k > 0 && shares.x(0) == 1 && shares.x(k - 1) == k &&
+                           (!modular || prime > BigInt(static_cast<unsigned long long>(k)));
+        if (!consecutive || cheapest.back() == k - 1) return cheapest;
+        double consecutiveCost = 0;
+        for (size_t i = 0; i < k; i++) {
+            double bits = shares.estimatedBits(i);
+            consecutiveCost += (shares.isDecoded(i) ? 0.0 : bits) + bits;
+        }
+        if (modular) {
+            cheapestCost += static_cast<double>(k) * k * prime.bitLength();
+        } else {
+            consecutiveCost += static_cast<double>(k) * k;  // binomial weights of about k bits each
+        }
+        if (consecutiveCost > cheapestCost) return cheapest;
+        std::vector<size_t> leading(k);
+        for (size_t i = 0; i < k; i++) leading[i] = i;
+        return leading;
+    }
+    
+    /**
+     * Decode stage: decodes the selected shares in place (ones already decoded
+     * are left alone)
+     */
+    static void decodeShares(ShareTable& shares, const std::vector<size_t>& selected) {
+        for (size_t i : selected) {
+            if (!shares.isDecoded(i)) {
+                shares.setY(i, decodeShare(shares.x(i), shares.base(i), shares.value(i)));
+            }
+        }
+    }
+    
+    static TieredValue decodeShare(uint64_t x, int base, std::string_view value) {
+        if (verbose) {
+            std::cout << "Processing index " << x << ": base=" << base 
+                     << ", value=" << value << std::endl;
+        }
+        
+        // 🔑 KEY STEP: Decode the value from its base to decimal
+        TieredValue y = decodeValue(value, base);
+        stageCounters.sharesDecoded++;
+        
+        if (verbose) {
+            std::cout << "  Decoded: " << value << " (base " << base 
+                     << ") = " << y.toString() << " (decimal)" << std::endl;
+        }
+        return y;
+    }
+    
+    /**
+     * The selected shares of a table as interpolation points (decoded already)
+     */
+    static std::vector<Root> selectedRoots(const ShareTable& shares, const std::vector<size_t>& selected) {
+        std::vector<Root> roots;
+        roots.reserve(selected.size());
+        for (size_t i : selected) {
+            roots.emplace_back(shares.x(i), shares.y(i));
+        }
+        return roots;
+    }
+    
+    /**
+     * Uses Lagrange interpolation to find the polynomial value at x=0
+     * This gives us the constant term of the polynomial
+     */
+    static BigInt lagrangeInterpolationAtZero(const std::vector<Root>& roots, int numPoints,
+                                              InterpolationMode mode = InterpolationMode::Exact) {
+        if (mode == InterpolationMode::FloatApprox) {
+            return lagrangeFloatAtZero(roots, numPoints);
+        }
+        if (mode == InterpolationMode::MultiModular) {
+            return multiModularAtZero(roots, numPoints);
+        }
+        if (ConsecutiveWeights::isConsecutiveFromOne(roots, numPoints)) {
+            return consecutiveExactAtZero(roots, numPoints);
+        }
+        return lagrangeExactAtZero(roots, numPoints);
+    }
+
+    /**
+     * Exact interpolation for x = 1..k: one dot product with the cached binomial weights
+     */
+    static BigInt consecutiveExactAtZero(const std::vector<Root>& roots, int numPoints) {
+        const std::vector<BigInt>& weights = ConsecutiveWeights::exact(numPoints);
+        if (verbose) {
+            std::cout << "Calculating constant term (consecutive x = 1.." << numPoints
+                      << ", cached weights):" << std::endl;
+        }
+        for (int i = 0; i < numPoints && verbose; i++) {
+            std::cout << "  Point " << roots[i].toString() << " -> basis = " << weights[i] << std::endl;
+        }
+        BigInt result = dotProduct(roots, weights, numPoints);
+        if (verbose) {
+            std::cout << "Final result at x=0: " << result << std::endl;
+        }
+        return result;
+    }
+
+    /**
+     * A decoded value as a field element; Word/DoubleWord values skip the
+     * BigInteger reduction
+     */
+    template <typename Field>
+    static typename Field::Element fieldValue(const Field& field, const TieredValue& y) {
+        if (y.tier == ValueTier::Big) return field.fromBigInt(y.big);
+        unsigned __int128 magnitude = y.small < 0 ? -static_cast<unsigned __int128>(y.small) : y.small;
+        typename Field::Element value = field.fromUint(static_cast<uint64_t>(magnitude));
+        if (y.tier == ValueTier::DoubleWord) {
+            // high * 2^64 + low, with 2^64 applied as 2^32 * 2^32
+            const typename Field::Element shift = field.fromUint(uint64_t(1) << 32);
+            typename Field::Element high = field.fromUint(static_cast<uint64_t>(magnitude >> 64));
+            value = field.add(field.mul(field.mul(high, shift), shift), value);
+        }
+        return y.small < 0 ? field.neg(value) : value;
+    }
+
+    /**
+     * Σ yi * weights[i]
+     * Stays in 128-bit machine arithmetic while every y is a Word/DoubleWord value,
+     * every weight fits in 64 bits and nothing overflows; otherwise uses BigInteger.
+     */
+    static BigInt dotProduct(const std::vector<Root>& roots, const std::vector<BigInt>& weights, int numPoints) {
+        __int128 accumulator = 0;
+        bool small = true;
+        for (int i = 0; i < numPoints && small; i++) {
+            if (roots[i].y.tier == ValueTier::Big || !weights[i].fitsInt64()) {
+                small = false;
+                break;
+            }
+            __int128 product;
+            small = !__builtin_mul_overflow(roots[i].y.small, static_cast<__int128>(weights[i].toInt64()), &product) &&
+                    !__builtin_add_overflow(accumulator, product, &accumulator);
+        }
+        if (small) {
+            return BigInt::fromInt128(accumulator);
+        }
+        BigInt result = 0;
+        for (int i = 0; i < numPoints; i++) {
+            result += roots[i].y.toBigInt() * weights[i];
+        }
+        return result;
+    }
+
+    /**
+     * GF(p) interpolation for x = 1..k: one dot product with the cached weights
+     */
+    template <typename Field>
+    static BigInt consecutiveModularAtZero(const Field& field, const std::vector<Root>& roots, int numPoints) {
+        using Element = typename Field::Element;
+        const std::vector<Element>& weights = ConsecutiveWeights::modular(field, numPoints);
+        Element result = field.zero();
+        for (int i = 0; i < numPoints; i++) {
+            result = field.add(result, field.mul(fieldValue(field, roots[i].y), weights[i]));
+        }
+        BigInt secret = field.toBigInt(result);
+        if (verbose) {
+            std::cout << "Calculating constant term mod p (consecutive x = 1.." << numPoints
+                      << ", cached weights): " << secret << std::endl;
+        }
+        return secret;
+    }
+
+    /**
+     * Exact Lagrange interpolation at x=0
+     * 
+     * Li(0) = Π(j≠i) (-xj) / Π(j≠i) (xi - xj) = num_i / den_i
+     * All terms are brought over the common denominator D = lcm(den_i), so
+     * c = Σ yi * num_i * (D / den_i) / D with a single exact division at the end.
+     */
+    static BigInt lagrangeExactAtZero(const std::vector<Root>& roots, int numPoints) {
+        if (verbose) {
+            std::cout << "Calculating constant term (exact) using " << numPoints << " points:" << std::endl;
+        }
+        
+        ExactWeights weights = exactLagrangeWeights(roots, numPoints);
+        
+        for (int i = 0; i < numPoints && verbose; i++) {
+            std::cout << "  Point " << roots[i].toString() << " -> basis = " << weights.numerators[i]
+                      << "/" << weights.denominator << std::endl;
+        }
+        BigInt resultNumerator = dotProduct(roots, weights.numerators, numPoints);
+        
+        BigInt result = divideRounded(resultNumerator, weights.denominator);
+        if (verbose) {
+            std::cout << "Final result at x=0: " << result << std::endl;
+        }
+        return result;
+    }
+
+    /**
+     * Lagrange weights at x=0 over a common denominator: Li(0) = numerators[i] / denominator
+     */
+    struct ExactWeights {
+        std::vector<BigInt> numerators;
+        BigInt denominator;
+    };
+
+    /**
+     * Li(0) = Π(j≠i) (-xj) / Π(j≠i) (xi - xj) = num_i / den_i, scaled onto D = lcm(den_i)
+     */
+    static ExactWeights exactLagrangeWeights(const std::vector<Root>& roots, int numPoints) {
+        std::vector<BigInt> numerators(numPoints), denominators(numPoints);
+        BigInt commonDenominator = 1;
+        
+        // Numerators Π(j≠i) (-xj) from prefix/suffix products instead of a double loop
+        std::vector<BigInt> suffix(numPoints + 1, BigInt(1));
+        for (int i = numPoints - 1; i >= 0; i--) {
+            suffix[i] = suffix[i + 1] * -BigInt(roots[i].x);
+        }
+        BigInt prefix = 1;
+        
+        for (int i = 0; i < numPoints; i++) {
+            BigInt numerator = prefix * suffix[i + 1];
+            prefix *= -BigInt(roots[i].x);
+            BigInt denominator = 1;
+            for (int j = 0; j < numPoints; j++) {
+                if (i != j) {
+                    denominator *= BigInt::fromInt128(static_cast<__int128>(roots[i].x) - roots[j].x);
+                }
+            }
+            if (denominator.isZero()) {
+                throw std::invalid_argument("Duplicate x-coordinate: " + std::to_string(roots[i].x));
+            }
+            // Keep the sign in the numerator so denominators stay positive
+            if (denominator.isNegative()) {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+            commonDenominator = commonDenominator / BigInt::gcd(commonDenominator, denominator) * denominator;
+            numerators[i] = std::move(numerator);
+            denominators[i] = std::move(denominator);
+        }
+        
+        for (int i = 0; i < numPoints; i++) {
+            numerators[i] *= commonDenominator / denominators[i];
+        }
+        return ExactWeights{std::move(numerators), std::move(commonDenominator)};
+    }
+
     /**
-     * Parses a JSON file and extracts the required data
-     * Returns a map with keys like "n", "k", "base_1", "value_1", etc.
+     * numerator / denominator (denominator > 0), rounded to nearest when inexact
+     * An inexact result means the points are not on an integer polynomial.
      */
-    static std::map<std::string, std::string> parseTestCase(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            throw std::runtime_error("Cannot open file: " + filename);
+    static BigInt divideRounded(const BigInt& numerator, const BigInt& denominator) {
+        BigInt quotient, remainder;
+        BigInt::divMod(numerator, denominator, quotient, remainder);
+        if (!remainder.isZero()) {
+            if (remainder.abs() * 2 >= denominator) {
+                quotient += numerator.isNegative() ? -1 : 1;
+            }
+            if (verbose) {
+                std::cout << "Warning: result " << numerator << "/" << denominator
+                          << " is not an integer, rounding" << std::endl;
+            }
+        }
+        return quotient;
+    }
+
+    /**
+     * Lagrange interpolation at x=0 over GF(p), returning the secret in [0, p)
+     * Picks the Montgomery backend from the prime's size: a single-word field
+     * for p < 2^64, fixed multi-limb fields up to 512 bits.
+     */
+    static BigInt lagrangeInterpolationModP(const BigInt& prime, const std::vector<Root>& roots, int numPoints) {
+        size_t bits = prime.bitLength();
+        // Consecutive x = 1..k needs p > k for distinct points; otherwise the general path reports it
+        if (ConsecutiveWeights::isConsecutiveFromOne(roots, numPoints) && prime > BigInt(numPoints)) {
+            if (bits <= 64) {
+                return consecutiveModularAtZero(MontgomeryField64(prime.limb(0)), roots, numPoints);
+            } else if (bits <= 128) {
+                return consecutiveModularAtZero(MontgomeryFieldN<2>(prime), roots, numPoints);
+            } else if (bits <= 256) {
+                return consecutiveModularAtZero(MontgomeryFieldN<4>(prime), roots, numPoints);
+            } else if (bits <= 512) {
+                return consecutiveModularAtZero(MontgomeryFieldN<8>(prime), roots, numPoints);
+            }
         }
+        if (bits <= 64) {
+            MontgomeryField64 field(prime.limb(0));
+            if (numPoints >= fastInterpolationThreshold) {
+                FieldPolynomials polys(field);
+                if (polys.supportsNtt(2 * static_cast<size_t>(numPoints))) {
+                    return fastLagrangeAtZero(polys, roots, numPoints);
+                }
+            }
+            return lagrangeModularAtZero(field, roots, numPoints);
+        } else if (bits <= 128) {
+            return lagrangeModularAtZero(MontgomeryFieldN<2>(prime), roots, numPoints);
+        } else if (bits <= 256) {
+            return lagrangeModularAtZero(MontgomeryFieldN<4>(prime), roots, numPoints);
+        } else if (bits <= 512) {
+            return lagrangeModularAtZero(MontgomeryFieldN<8>(prime), roots, numPoints);
+        }
+        throw std::invalid_argument("Prime too large for GF(p) interpolation (max 512 bits): " + prime.toString());
+    }
+
+    /**
+     * Subquadratic Lagrange interpolation at x=0 over an NTT-friendly 64-bit prime
+     * 
+     * The denominators Π(j≠i) (xi - xj) are M'(xi) for M(x) = Π (x - xj), so they
+     * come from one multipoint evaluation of M' on the subproduct tree:
+     * O(k log² k) field operations instead of O(k²).
+     */
+    static BigInt fastLagrangeAtZero(const FieldPolynomials& polys, const std::vector<Root>& roots, int numPoints) {
+        using Element = FieldPolynomials::Element;
+        const MontgomeryField64& field = polys.field();
         
-        // Read entire file content
-        std::string content((std::istreambuf_iterator<char>(file)),
-                           std::istreambuf_iterator<char>());
-        file.close();
+        if (verbose) {
+            std::cout << "Calculating constant term mod p (subproduct tree) using " << numPoints
+                      << " points" << std::endl;
+        }
         
-        std::map<std::string, std::string> result;
+        std::vector<Element> weights = fastModularLagrangeWeights(polys, roots, numPoints);
+        Element result = field.zero();
+        for (int i = 0; i < numPoints; i++) {
+            result = field.add(result, field.mul(fieldValue(field, roots[i].y), weights[i]));
+        }
         
-        // Remove all whitespace and newlines for easier parsing
-        content.erase(std::remove_if(content.begin(), content.end(), ::isspace), content.end());
+        BigInt secret = field.toBigInt(result);
+        if (verbose) {
+            std::cout << "Final result at x=0 (mod p): " << secret << std::endl;
+        }
+        return secret;
+    }
+
+    /**
+     * Lagrange weights Li(0) over an NTT-friendly 64-bit prime via the subproduct tree
+     */
+    static std::vector<FieldPolynomials::Element> fastModularLagrangeWeights(const FieldPolynomials& polys,
+                                                                            const std::vector<Root>& roots,
+                                                                            int numPoints) {
+        using Element = FieldPolynomials::Element;
+        const MontgomeryField64& field = polys.field();
+        std::vector<Element> xs;
+        for (int i = 0; i < numPoints; i++) {
+            xs.push_back(field.fromUint(roots[i].x));
+        }
         
-        try {
-            // Parse keys section: "keys":{"n":4,"k":3}
-            std::regex keysRegex("\"keys\":\\{\"n\":(\\d+),\"k\":(\\d+)\\}");
-            std::smatch keysMatch;
-            if (std::regex_search(content, keysMatch, keysRegex)) {
-                result["n"] = keysMatch[1].str();
-                result["k"] = keysMatch[2].str();
-            }
-            
-            // Parse data entries: "1":{"base":"10","value":"4"}
-            std::regex entryRegex("\"(\\d+)\":\\{\"base\":\"(\\d+)\",\"value\":\"([^\"]+)\"\\}");
-            std::sregex_iterator iter(content.begin(), content.end(), entryRegex);
-            std::sregex_iterator end;
-            
-            for (; iter != end; ++iter) {
-                std::string index = (*iter)[1].str();
-                std::string base = (*iter)[2].str();
-                std::string value = (*iter)[3].str();
-                result["base_" + index] = base;
-                result["value_" + index] = value;
+        SubproductTree tree(polys, xs);
+        std::vector<Element> denominators = tree.evaluate(polys.derivative(tree.root()));
+        for (int i = 0; i < numPoints; i++) {
+            if (denominators[i] == field.zero()) {
+                throw std::invalid_argument("Duplicate x-coordinate mod p: " + std::to_string(roots[i].x));
             }
-            
-        } catch (const std::exception& e) {
-            throw std::runtime_error("JSON parsing failed: " + std::string(e.what()));
         }
+        batchInvert(field, denominators);
         
-        return result;
+        // Numerators Π(j≠i) (-xj) from prefix/suffix products
+        std::vector<Element> suffix(numPoints + 1, field.one());
+        for (int i = numPoints - 1; i >= 0; i--) {
+            suffix[i] = field.mul(suffix[i + 1], field.neg(xs[i]));
+        }
+        std::vector<Element> weights(numPoints);
+        Element prefix = field.one();
+        for (int i = 0; i < numPoints; i++) {
+            weights[i] = field.mul(field.mul(prefix, suffix[i + 1]), denominators[i]);
+            prefix = field.mul(prefix, field.neg(xs[i]));
+        }
+        return weights;
     }
-};
 
-/**
- * Polynomial Solver - Finds constant c using Lagrange interpolation
- * 
- * This program:
- * 1. Reads JSON files containing encoded values in different bases
- * 2. Decodes the y-values from their respective bases to decimal
- * 3. Uses Lagrange interpolation to find the constant term at x=0
- * 4. Uses standard C++ types (supports numbers up to ~9 × 10^18)
- */
-class PolynomialSolver {
-private:
     /**
-     * Represents a single root point (x, y) where:
-     * x = the x-coordinate (input value)
-     * y = the y-coordinate (decoded from base-encoded string)
+     * Field-generic Lagrange interpolation at x=0
+     * Field supplies Element, fromBigInt/toBigInt, add/sub/neg/mul/inv (see MontgomeryField64).
      */
-    struct Root {
-        BigInt x; // x-coordinate (usually the index from JSON)
-        BigInt y; // y-coordinate (decoded from base-encoded value)
+    template <typename Field>
+    static BigInt lagrangeModularAtZero(const Field& field, const std::vector<Root>& roots, int numPoints) {
+        using Element = typename Field::Element;
         
-        Root(BigInt x_val, BigInt y_val) : x(x_val), y(y_val) {}
+        if (verbose) {
+            std::cout << "Calculating constant term mod p using " << numPoints << " points:" << std::endl;
+        }
         
-        std::string toString() const {
-            return "(" + std::to_string(x) + ", " + std::to_string(y) + ")";
+        std::vector<Element> weights = modularLagrangeWeights(field, roots, numPoints);
+        
+        Element result = field.zero();
+        for (int i = 0; i < numPoints; i++) {
+            if (verbose) {
+                std::cout << "  Point " << roots[i].toString() << " -> basis = "
+                          << field.toBigInt(weights[i]) << " (mod p)" << std::endl;
+            }
+            result = field.add(result, field.mul(fieldValue(field, roots[i].y), weights[i]));
         }
-    };
-    
+        
+        BigInt secret = field.toBigInt(result);
+        if (verbose) {
+            std::cout << "Final result at x=0 (mod p): " << secret << std::endl;
+        }
+        return secret;
+    }
+
     /**
-     * Container for a complete test case
-     * Holds the metadata (n, k) and all the roots
+     * Lagrange weights Li(0) in GF(p) for the first numPoints roots
      */
-    struct TestCase {
-        int n;                    // Number of roots
-        int k;                    // Parameter k
-        std::vector<Root> roots;  // All decoded roots
+    template <typename Field>
+    static std::vector<typename Field::Element> modularLagrangeWeights(const Field& field,
+                                                                       const std::vector<Root>& roots,
+                                                                       int numPoints) {
+        using Element = typename Field::Element;
+        std::vector<Element> xs;
+        for (int i = 0; i < numPoints; i++) {
+            xs.push_back(field.fromUint(roots[i].x));
+        }
         
-        TestCase(int n_val, int k_val, const std::vector<Root>& roots_val) 
-            : n(n_val), k(k_val), roots(roots_val) {}
-    };
+        // Numerators Π(j≠i) (-xj) from prefix/suffix products: O(k) multiplications
+        std::vector<Element> suffix(numPoints + 1, field.one());
+        for (int i = numPoints - 1; i >= 0; i--) {
+            suffix[i] = field.mul(suffix[i + 1], field.neg(xs[i]));
+        }
+        
+        // Denominators Π(j≠i) (xi - xj), all inverted together with one field inversion
+        std::vector<Element> denominators(numPoints, field.one());
+        for (int i = 0; i < numPoints; i++) {
+            for (int j = 0; j < numPoints; j++) {
+                if (i != j) {
+                    denominators[i] = field.mul(denominators[i], field.sub(xs[i], xs[j]));
+                }
+            }
+            if (denominators[i] == field.zero()) {
+                throw std::invalid_argument("Duplicate x-coordinate mod p: " + std::to_string(roots[i].x));
+            }
+        }
+        batchInvert(field, denominators);
+        
+        // Li(0) = Π(j≠i) (-xj) / Π(j≠i) (xi - xj)
+        std::vector<Element> weights(numPoints);
+        Element prefix = field.one();
+        for (int i = 0; i < numPoints; i++) {
+            weights[i] = field.mul(field.mul(prefix, suffix[i + 1]), denominators[i]);
+            prefix = field.mul(prefix, field.neg(xs[i]));
+        }
+        return weights;
+    }
+
+    // Up to this many shares solveConsensus tabulates every 1 / (xi - xj)
+    static constexpr size_t kConsensusTableShares = 512;
 
-public:
     /**
-     * Result class to hold the processed test case data
-     * Contains n, k, decoded roots, and calculated constant c
+     * One fingerprint field of solveConsensus: x, 1/x and y of every share mod p,
+     * plus 1 / (xb - xi) at [b * n + i] for small n
      */
-    struct ProcessResult {
-        int n;                    // Number of roots
-        int k;                    // Parameter k from JSON
-        std::vector<Root> roots;  // List of decoded (x, y) coordinates
-        BigInt constantC;         // Calculated constant c
-        
-        ProcessResult(int n_val, int k_val, const std::vector<Root>& roots_val, BigInt constantC_val)
-            : n(n_val), k(k_val), roots(roots_val), constantC(constantC_val) {}
+    struct ConsensusField {
+        MontgomeryField64 field;
+        std::vector<MontgomeryField64::Element> xs, inverseXs, ys;
+        std::vector<MontgomeryField64::Element> inverseDifferences;
     };
 
     /**
-     * Main entry point for processing a single test case file
+     * Li(0) = Π(j≠i) xj / (xj - xi) for the subset `members`, from scratch in O(k²)
      */
-    static ProcessResult processTestCase(const std::string& filename) {
-        TestCase testCase = readTestCase(filename);
-        BigInt constantC = solvePolynomial(testCase);
-        return ProcessResult(testCase.n, testCase.k, testCase.roots, constantC);
+    static void consensusWeights(const ConsensusField& lane, const std::vector<size_t>& members,
+                                 std::vector<MontgomeryField64::Element>& weights) {
+        const MontgomeryField64& field = lane.field;
+        std::vector<MontgomeryField64::Element> denominators(members.size(), field.one());
+        for (size_t i = 0; i < members.size(); i++) {
+            weights[i] = field.one();
+            for (size_t j = 0; j < members.size(); j++) {
+                if (i == j) continue;
+                weights[i] = field.mul(weights[i], lane.xs[members[j]]);
+                denominators[i] = field.mul(denominators[i], field.sub(lane.xs[members[j]], lane.xs[members[i]]));
+            }
+        }
+        batchInvert(field, denominators);
+        for (size_t i = 0; i < members.size(); i++) weights[i] = field.mul(weights[i], denominators[i]);
     }
 
     /**
-     * Main method - runs both test cases automatically
+     * Weights after share `removed` left slot `slot` and members[slot] entered:
+     * every other weight trades the factor xa / (xa - xi) for xb / (xb - xi), and
+     * the entering one is Π xi / (xi - xb), all from one batch of inverses (or
+     * the lane's table)
      */
-    static void runTests() {
-        try {
-            // Test case 1
-            std::cout << "=== Test Case 1 ===" << std::endl;
-            TestCase testCase1 = readTestCase("test_case_1.json");
-            std::cout << "Found " << testCase1.roots.size() << " roots:" << std::endl;
-            for (const auto& root : testCase1.roots) {
-                std::cout << "  " << root.toString() << std::endl;
-            }
-            
-            BigInt constantC1 = solvePolynomial(testCase1);
-            std::cout << "Constant c for test case 1: " << constantC1 << std::endl;
-            
-            std::cout << "\n=== Test Case 2 ===" << std::endl;
-            TestCase testCase2 = readTestCase("test_case_2.json");
-            std::cout << "Found " << testCase2.roots.size() << " roots:" << std::endl;
-            for (size_t i = 0; i < std::min(testCase2.roots.size(), size_t(5)); ++i) {
-                std::cout << "  " << testCase2.roots[i].toString() << std::endl;
-            }
-            if (testCase2.roots.size() > 5) {
-                std::cout << "  ... and " << (testCase2.roots.size() - 5) << " more roots" << std::endl;
+    static void swapConsensusWeight(const ConsensusField& lane, const std::vector<size_t>& members, size_t slot,
+                                    size_t removed, std::vector<MontgomeryField64::Element>& weights,
+                                    std::vector<MontgomeryField64::Element>& inverses) {
+        using Element = MontgomeryField64::Element;
+        const MontgomeryField64& field = lane.field;
+        const Element xa = lane.xs[removed], xb = lane.xs[members[slot]];
+        if (!lane.inverseDifferences.empty()) {
+            const MontgomeryField64::Element* row = lane.inverseDifferences.data() + members[slot] * lane.xs.size();
+            for (size_t i = 0; i < members.size(); i++) inverses[i] = row[members[i]];
+        } else {
+            for (size_t i = 0; i < members.size(); i++) {
+                inverses[i] = i == slot ? field.one() : field.sub(xb, lane.xs[members[i]]);
             }
-            
-            BigInt constantC2 = solvePolynomial(testCase2);
-            std::cout << "Constant c for test case 2: " << constantC2 << std::endl;
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Error: " << e.what() << std::endl;
+            batchInvert(field, inverses);
         }
+        const Element scale = field.mul(xb, lane.inverseXs[removed]);
+        Element entering = field.one();
+        for (size_t i = 0; i < members.size(); i++) {
+            if (i == slot) continue;
+            const Element xi = lane.xs[members[i]];
+            weights[i] = field.mul(weights[i], field.mul(scale, field.mul(inverses[i], field.sub(xa, xi))));
+            entering = field.mul(entering, field.mul(xi, field.neg(inverses[i])));
+        }
+        weights[slot] = entering;
+    }
+
+    static uint64_t consensusValue(const ConsensusField& lane, const std::vector<size_t>& members,
+                                   const std::vector<MontgomeryField64::Element>& weights) {
+        MontgomeryField64::Element value = lane.field.zero();
+        for (size_t i = 0; i < members.size(); i++) {
+            value = lane.field.add(value, lane.field.mul(lane.ys[members[i]], weights[i]));
+        }
+        return lane.field.toUint(value);
     }
 
-private:
     /**
-     * Reads and parses a JSON test case file using simple regex parsing
+     * Multi-modular exact interpolation at x=0
      * 
-     * JSON Structure:
-     * {
-     *   "keys": {"n": 4, "k": 3},
-     *   "1": {"base": "10", "value": "4"},
-     *   "2": {"base": "2", "value": "111"},
-     *   ...
-     * }
+     * The constant is computed independently modulo enough 62-bit primes to
+     * cover |c| (bound: max bits(yi) + bits of Σ|Li(0)| + sign), with the
+     * residues spread over worker threads, then lifted with a balanced CRT tree.
      */
-    static TestCase readTestCase(const std::string& filename) {
-        // Parse JSON using simple parser
-        auto jsonData = SimpleJsonParser::parseTestCase(filename);
-        
-        // Extract metadata from parsed data
-        int n = std::stoi(jsonData.at("n"));  // Number of roots
-        int k = std::stoi(jsonData.at("k"));  // Parameter k
-        
-        std::cout << "Parsing test case: n=" << n << ", k=" << k << std::endl;
+    static BigInt multiModularAtZero(const std::vector<Root>& roots, int numPoints) {
+        std::vector<uint64_t> sortedXs;
+        size_t maxYBits = 0;
+        size_t weightBits = 0;  // log2 of Σ|Li(0)| ≤ k * max Π(j≠i)|xj|
+        for (int i = 0; i < numPoints; i++) {
+            sortedXs.push_back(roots[i].x);
+            maxYBits = std::max(maxYBits, roots[i].y.bitLength());
+            weightBits += roots[i].x == 0 ? 0 : 64 - __builtin_clzll(roots[i].x);
+        }
+        std::sort(sortedXs.begin(), sortedXs.end());
+        auto duplicate = std::adjacent_find(sortedXs.begin(), sortedXs.end());
+        if (duplicate != sortedXs.end()) {
+            throw std::invalid_argument("Duplicate x-coordinate: " + std::to_string(*duplicate));
+        }
+        if (ConsecutiveWeights::isConsecutiveFromOne(roots, numPoints)) {
+            weightBits = static_cast<size_t>(numPoints);  // Σ C(k, i) = 2^k - 1
+        }
+        size_t log2k = 0;
+        while ((size_t(1) << log2k) < static_cast<size_t>(numPoints)) log2k++;
+        size_t bits = maxYBits + weightBits + log2k + 2;
+        size_t needed = (bits + 60) / 61;  // every CRT prime exceeds 2^61
         
-        std::vector<Root> roots;
+        if (verbose) {
+            std::cout << "Calculating constant term via CRT: bound " << bits << " bits, " << needed
+                      << " primes of 62 bits" << std::endl;
+        }
         
-        // Parse each root from the parsed data
-        // Note: We need to check all possible indices, not just 1 to n
-        // because some test cases might have gaps (like test_case_1.json has index 6)
-        for (int i = 1; i <= 20; i++) { // Check up to 20 to catch any gaps
-            std::string baseKey = "base_" + std::to_string(i);
-            std::string valueKey = "value_" + std::to_string(i);
+        std::vector<uint64_t> residues, moduli;
+        size_t nextPrime = 0;
+        while (moduli.size() < needed) {
+            // A prime dividing some (xi - xj) cannot be used; replace it with the next one
+            size_t missing = needed - moduli.size();
+            std::vector<uint64_t> candidates = CrtToolkit::primes(nextPrime + missing);
+            candidates.erase(candidates.begin(), candidates.begin() + nextPrime);
+            nextPrime += missing;
             
-            if (jsonData.find(baseKey) != jsonData.end() && 
-                jsonData.find(valueKey) != jsonData.end()) {
-                
-                std::string base = jsonData.at(baseKey);    // e.g., "2", "10", "16"
-                std::string value = jsonData.at(valueKey);  // e.g., "111", "4", "a1b2"
-                
-                std::cout << "Processing index " << i << ": base=" << base 
-                         << ", value=" << value << std::endl;
-                
-                // 🔑 KEY STEP: Decode the value from its base to decimal
-                BigInt decodedValue = decodeFromBase(value, base);
-                
-                // For this problem, we'll treat the decoded value as y
-                // and use the index i as x
-                BigInt x = static_cast<BigInt>(i);  // x = index (1, 2, 3, ...)
-                BigInt y = decodedValue; // y = decoded value from base
-                
-                std::cout << "  Decoded: " << value << " (base " << base 
-                         << ") = " << y << " (decimal)" << std::endl;
-                
-                roots.emplace_back(x, y);
+            std::vector<uint64_t> candidateResidues(candidates.size());
+            std::vector<char> usable(candidates.size(), 0);
+            std::atomic<size_t> cursor(0);
+            auto worker = [&] {
+                for (size_t index = cursor++; index < candidates.size(); index = cursor++) {
+                    try {
+                        candidateResidues[index] = residueAtZero(MontgomeryField64(candidates[index]), roots, numPoints);
+                        usable[index] = 1;
+                    } catch (const std::invalid_argument&) {
+                        usable[index] = 0;
+                    }
+                }
+            };
+            size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), candidates.size());
+            std::vector<std::thread> threads;
+            for (size_t t = 1; t < threadCount; t++) threads.emplace_back(worker);
+            worker();
+            for (std::thread& thread : threads) thread.join();
+            
+            for (size_t i = 0; i < candidates.size(); i++) {
+                if (usable[i]) {
+                    residues.push_back(candidateResidues[i]);
+                    moduli.push_back(candidates[i]);
+                }
             }
         }
         
-        std::cout << "Successfully parsed " << roots.size() << " roots" << std::endl;
-        return TestCase(n, k, roots);
+        BigInt result = CrtToolkit::reconstructSymmetric(residues, moduli);
+        if (verbose) {
+            std::cout << "Final result at x=0: " << result << std::endl;
+        }
+        return result;
     }
-    
+
     /**
-     * Main polynomial solving logic using Lagrange interpolation
-     * 
-     * Strategy:
-     * Use Lagrange interpolation to find the constant term at x=0
+     * c mod p for one 64-bit prime (thread-safe, no logging)
+     * Uses the cached consecutive table, the subproduct tree or the O(k²) weights.
      */
-    static BigInt solvePolynomial(const TestCase& testCase) {
-        const std::vector<Root>& roots = testCase.roots;
-        
-        if (roots.empty()) {
-            throw std::invalid_argument("No roots provided");
+    static uint64_t residueAtZero(const MontgomeryField64& field, const std::vector<Root>& roots, int numPoints) {
+        using Element = MontgomeryField64::Element;
+        std::vector<Element> weights;
+        if (ConsecutiveWeights::isConsecutiveFromOne(roots, numPoints) &&
+            field.modulus() > static_cast<uint64_t>(numPoints)) {
+            weights = ConsecutiveWeights::modular(field, numPoints);
+        } else if (numPoints >= fastInterpolationThreshold &&
+                   FieldPolynomials(field).supportsNtt(2 * static_cast<size_t>(numPoints))) {
+            weights = fastModularLagrangeWeights(FieldPolynomials(field), roots, numPoints);
+        } else {
+            weights = modularLagrangeWeights(field, roots, numPoints);
         }
-        
-        std::cout << "Solving polynomial with " << roots.size() << " roots" << std::endl;
-        std::cout << "Using k=" << testCase.k << " points for interpolation" << std::endl;
-        
-        // Use exactly k points for Lagrange interpolation
-        int numPoints = std::min(testCase.k, static_cast<int>(roots.size()));
-        
-        return lagrangeInterpolationAtZero(roots, numPoints);
+        Element result = field.zero();
+        for (int i = 0; i < numPoints; i++) {
+            result = field.add(result, field.mul(fieldValue(field, roots[i].y), weights[i]));
+        }
+        return field.toUint(result);
     }
-    
+
     /**
-     * Uses Lagrange interpolation to find the polynomial value at x=0
-     * This gives us the constant term of the polynomial
+     * Approximate Lagrange interpolation in long double arithmetic
+     * Only accurate while the result fits in the 64-bit mantissa.
      */
-    static BigInt lagrangeInterpolationAtZero(const std::vector<Root>& roots, int numPoints) {
+    static BigInt lagrangeFloatAtZero(const std::vector<Root>& roots, int numPoints) {
         BigFloat result = 0.0;
         
-        std::cout << "Calculating constant term using " << numPoints << " points:" << std::endl;
+        if (verbose) {
+            std::cout << "Calculating constant term (float) using " << numPoints << " points:" << std::endl;
+        }
         
         for (int i = 0; i < numPoints; i++) {
-            BigFloat yi = static_cast<BigFloat>(roots[i].y);
+            BigFloat yi = roots[i].y.tier == ValueTier::Big ? roots[i].y.big.toLongDouble()
+                                                            : static_cast<BigFloat>(roots[i].y.small);
             BigFloat xi = static_cast<BigFloat>(roots[i].x);
             
             // Calculate Li(0) = Π(j≠i) (-xj) / (xi - xj)
@@ -272,15 +5579,19 @@ private:
                 }
             }
             
-            std::cout << "  Point " << roots[i].toString() << " -> basis = " << lagrangeBasis << std::endl;
+            if (verbose) {
+                std::cout << "  Point " << roots[i].toString() << " -> basis = " << lagrangeBasis << std::endl;
+            }
             
             result += yi * lagrangeBasis;
         }
         
-        std::cout << "Final result at x=0: " << result << std::endl;
+        if (verbose) {
+            std::cout << "Final result at x=0: " << result << std::endl;
+        }
         
         // Round to nearest integer
-        return static_cast<BigInt>(std::round(result));
+        return BigInt::fromLongDouble(std::round(result));
     }
     
     /**
@@ -291,46 +5602,283 @@ private:
      * - "213" (base 4) → 39 (decimal)
      * - "a1b2" (base 16) → 41394 (decimal)
      */
-    static BigInt decodeFromBase(const std::string& value, const std::string& baseStr) {
-        int base = std::stoi(baseStr);
+    static BigInt decodeFromBase(std::string_view value, std::string_view baseStr) {
+        int base = std::stoi(std::string(baseStr));
+        if (base < 2 || base > 36) {
+            throw std::invalid_argument("Unsupported base: " + std::string(baseStr));
+        }
+        return decodeFromBase(value, base);
+    }
+    
+    static BigInt decodeFromBase(std::string_view value, int base) {
+        TieredValue decoded = decodeValue(value, base);
+        return decoded.tier == ValueTier::Big ? std::move(decoded.big) : BigInt::fromInt128(decoded.small);
+    }
+    
+    /**
+     * decodeFromBase tagged with the value's tier: Word and DoubleWord values
+     * come back as a machine integer and never build a BigInteger
+     */
+    static TieredValue decodeValue(std::string_view value, int base) {
+        if (base < 2 || base > 36) {
+            throw std::invalid_argument("Unsupported base: " + std::to_string(base));
+        }
         
-        // Convert character to digit value
-        auto charToDigit = [](char c) -> int {
-            if (c >= '0' && c <= '9') {
-                return c - '0';
-            } else if (c >= 'a' && c <= 'z') {
-                return c - 'a' + 10;
-            } else if (c >= 'A' && c <= 'Z') {
-                return c - 'A' + 10;
+        const uint64_t groupMultiplier = static_cast<uint64_t>(base) * base * base * base;
+        
+        // Magnitude estimate: value < base^len, so it needs at most len * log2(base) bits
+        double estimatedBits = static_cast<double>(value.length()) * std::log2(static_cast<double>(base));
+        
+        if (estimatedBits <= 128) {
+            // Word and DoubleWord tiers: at most 128 digits, so the buffers live on the stack
+            uint8_t digits[kSmallTierDigits + 3];
+            uint32_t groups[(kSmallTierDigits + 3) / 4];
+            size_t groupCount = toGroups(value, base, digits, groups);
+            if (estimatedBits <= 64) {
+                // Word tier: plain 64-bit Horner over groups, cannot overflow
+                uint64_t result = 0;
+                for (size_t i = 0; i < groupCount; i++) {
+                    result = result * groupMultiplier + groups[i];
+                }
+                return TieredValue::fromUnsigned128(result);
             }
-            throw std::invalid_argument("Invalid character in base conversion: " + std::string(1, c));
-        };
+            // DoubleWord tier: 128-bit Horner over groups, cannot overflow
+            unsigned __int128 result = 0;
+            for (size_t i = 0; i < groupCount; i++) {
+                result = result * groupMultiplier + groups[i];
+            }
+            return TieredValue::fromUnsigned128(result);
+        }
+        
+        std::vector<uint8_t> digits(value.length() + 3);
+        std::vector<uint32_t> groups((value.length() + 3) / 4);
+        groups.resize(toGroups(value, base, digits.data(), groups.data()));
+        
+        if ((base & (base - 1)) == 0) {
+            return TieredValue(decodePowerOfTwo(groups, base));
+        }
+        
+        if (value.length() >= divideConquerDecodeThreshold) {
+            return TieredValue(decodeDivideConquer(groups, base));
+        }
         
+        // Big tier: Horner's rule over word-sized chunks of groups. Each chunk is
+        // accumulated in a 64-bit register, then folded into the result with one
+        // in-place limb multiply-add by base^chunkDigits.
+        const DigitChunk& chunk = digitChunk(base);
         BigInt result = 0;
-        BigInt baseMultiplier = 1;
+        result.reserveLimbs(static_cast<size_t>(estimatedBits / 64) + 2);
         
-        // Process digits from right to left
-        for (int i = static_cast<int>(value.length()) - 1; i >= 0; i--) {
-            int digitValue = charToDigit(value[i]);
-            
-            if (digitValue >= base) {
-                throw std::invalid_argument("Digit value " + std::to_string(digitValue) + 
-                                          " is invalid for base " + std::to_string(base));
+        size_t position = groups.size() % chunk.groups;
+        uint64_t headValue = 0;
+        for (size_t i = 0; i < position; i++) {
+            headValue = headValue * groupMultiplier + groups[i];
+        }
+        result.mulAddSmall(0, headValue);
+        
+        for (; position < groups.size(); position += chunk.groups) {
+            uint64_t chunkValue = 0;
+            for (size_t i = position; i < position + chunk.groups; i++) {
+                chunkValue = chunkValue * groupMultiplier + groups[i];
             }
-            
-            result += static_cast<BigInt>(digitValue) * baseMultiplier;
-            baseMultiplier *= base;
+            result.mulAddSmall(chunk.multiplier, chunkValue);
         }
         
-        return result;
+        return TieredValue(std::move(result));
+    }
+
+    // Longest value (base 2) that still fits the DoubleWord tier
+    static constexpr size_t kSmallTierDigits = 128;
+
+    /**
+     * Maps and validates all characters in bulk (SIMD where available), then packs
+     * every 4 digits into one group value. `digits` (room for value.length() + 3)
+     * is front-padded with zeros to a multiple of 4, which leaves the value
+     * unchanged; returns the number of groups written to `groups`.
+     */
+    static size_t toGroups(std::string_view value, int base, uint8_t* digits, uint32_t* groups) {
+        size_t padding = (4 - value.length() % 4) % 4;
+        std::memset(digits, 0, padding);
+        size_t invalid = DigitKernels::toDigits(value.data(), value.length(), base, digits + padding);
+        if (invalid != DigitKernels::npos) {
+            char c = value[invalid];
+            int digitValue = -1;
+            if (c >= '0' && c <= '9') {
+                digitValue = c - '0';
+            } else if (c >= 'a' && c <= 'z') {
+                digitValue = c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'Z') {
+                digitValue = c - 'A' + 10;
+            }
+            if (digitValue >= base) {
+                throw std::invalid_argument("Digit value " + std::to_string(digitValue) +
+                                            " is invalid for base " + std::to_string(base));
+            }
+            throw std::invalid_argument("Invalid character in base conversion: " + std::string(1, c));
+        }
+        size_t groupCount = (value.length() + padding) / 4;
+        DigitKernels::packGroups(digits, groupCount, base, groups);
+        return groupCount;
+    }
+
+    /**
+     * Power-of-two bases (2, 4, 8, 16, 32): the value is a plain concatenation of
+     * the groups' bits (4 * log2(base) bits each), so limbs are filled with shifts
+     * from the least significant group upwards - no multiplication at all
+     */
+    static BigInt decodePowerOfTwo(const std::vector<uint32_t>& groups, int base) {
+        const unsigned groupBits = 4 * static_cast<unsigned>(__builtin_ctz(static_cast<unsigned>(base)));
+        std::vector<uint64_t> limbs((groups.size() * groupBits + 63) / 64);
+        size_t limbIndex = 0;
+        unsigned filled = 0;
+        uint64_t current = 0;
+        for (size_t i = groups.size(); i-- > 0;) {
+            uint64_t group = groups[i];
+            current |= group << filled;
+            filled += groupBits;
+            if (filled >= 64) {
+                limbs[limbIndex++] = current;
+                filled -= 64;
+                current = filled ? group >> (groupBits - filled) : 0;
+            }
+        }
+        if (filled) limbs[limbIndex++] = current;
+        return BigInt::fromLimbs(limbs.data(), limbIndex);
+    }
+
+    /**
+     * Subquadratic decoding for very long values
+     * The 4-digit groups are cut into word-sized chunks from the right, then
+     * merged pairwise as hi * base^len(lo) + lo, where the low half always spans
+     * 2^j chunks so its multiplier comes from the cached power tree. Cost is
+     * dominated by a few large (Karatsuba) multiplications instead of a
+     * quadratic number of limb passes.
+     */
+    static BigInt decodeDivideConquer(const std::vector<uint32_t>& groups, int base) {
+        const DigitChunk& chunk = digitChunk(base);
+        const uint64_t groupMultiplier = static_cast<uint64_t>(base) * base * base * base;
+        // chunks[0] is the least significant chunk
+        std::vector<uint64_t> chunks((groups.size() + chunk.groups - 1) / chunk.groups);
+        for (size_t i = 0; i < chunks.size(); i++) {
+            size_t end = groups.size() - i * chunk.groups;
+            size_t begin = end >= chunk.groups ? end - chunk.groups : 0;
+            uint64_t chunkValue = 0;
+            for (size_t position = begin; position < end; position++) {
+                chunkValue = chunkValue * groupMultiplier + groups[position];
+            }
+            chunks[i] = chunkValue;
+        }
+        return combineChunks(chunks, 0, chunks.size(), base);
+    }
+
+    // Value of chunks[first, first + count) in base^chunkDigits positional notation
+    static BigInt combineChunks(const std::vector<uint64_t>& chunks, size_t first, size_t count, int base) {
+        const size_t kLeafChunks = 32;
+        if (count <= kLeafChunks) {
+            BigInt result = 0;
+            result.reserveLimbs(count + 1);
+            for (size_t i = first + count; i-- > first;) {
+                result.mulAddSmall(digitChunk(base).multiplier, chunks[i]);
+            }
+            return result;
+        }
+        // Low part: the largest power-of-two number of chunks below count
+        size_t level = 0;
+        while ((size_t(2) << level) < count) level++;
+        size_t lowCount = size_t(1) << level;
+        BigInt high = combineChunks(chunks, first + lowCount, count - lowCount, base);
+        BigInt low = combineChunks(chunks, first, lowCount, base);
+        return high * chunkPower(base, level) + low;
+    }
+
+    /**
+     * Cached power tree: base^(chunkDigits * 2^level), shared across calls and threads
+     */
+    static const BigInt& chunkPower(int base, size_t level) {
+        static std::map<int, std::deque<BigInt>> cache;
+        static std::mutex cacheMutex;
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        std::deque<BigInt>& powers = cache[base];
+        if (powers.empty()) powers.push_back(BigInt::fromUnsigned(digitChunk(base).multiplier));
+        while (powers.size() <= level) powers.push_back(powers.back() * powers.back());
+        return powers[level];
+    }
+
+    /**
+     * Largest run of 4-digit groups per base whose value always fits in one 64-bit
+     * limb, e.g. 4 groups (16 digits) for base 10 and 10 groups (40 digits) for
+     * base 3; multiplier = base^(4 * groups)
+     */
+    struct DigitChunk {
+        size_t groups;
+        uint64_t multiplier;
+    };
+
+    static const DigitChunk& digitChunk(int base) {
+        static const std::array<DigitChunk, 37> table = [] {
+            std::array<DigitChunk, 37> chunks{};
+            for (uint64_t b = 2; b <= 36; b++) {
+                uint64_t groupMultiplier = b * b * b * b;
+                DigitChunk chunk{0, 1};
+                while (chunk.multiplier <= UINT64_MAX / groupMultiplier) {
+                    chunk.multiplier *= groupMultiplier;
+                    chunk.groups++;
+                }
+                chunks[b] = chunk;
+            }
+            return chunks;
+        }();
+        return table[base];
     }
 };
 
 // Main function
-int main() {
+// Pass --bench to run the benchmarks instead of the test cases; --robust or
+// --consensus followed by files reconstructs despite wrong shares
+int main(int argc, char** argv) {
     std::cout << "Polynomial Solver C++ Version (Lagrange Interpolation)" << std::endl;
     std::cout << "=======================================================" << std::endl;
     
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        PolynomialSolver::runBenchmarks();
+        return 0;
+    }
+    
+    if (argc > 1) {
+        // Explicit input files ("-" reads the test case from stdin); after --robust,
+        // wrong shares are corrected and listed, after --consensus k-subsets vote
+        bool robust = std::string(argv[1]) == "--robust";
+        bool consensus = std::string(argv[1]) == "--consensus";
+        int status = 0;
+        for (int i = robust || consensus ? 2 : 1; i < argc; i++) {
+            try {
+                if (consensus) {
+                    PolynomialSolver::ConsensusResult result = PolynomialSolver::processConsensus(argv[i]);
+                    std::cout << "Constant c for " << argv[i] << ": " << result.constantC << std::endl;
+                    std::cout << "Consensus in " << argv[i] << ": " << result.votes << " of " << result.subsets
+                              << " subsets agree (" << result.evaluated << " evaluated, runner-up "
+                              << result.runnerUpVotes << ")" << std::endl;
+                    continue;
+                }
+                if (robust) {
+                    PolynomialSolver::RobustResult result = PolynomialSolver::processRobust(argv[i]);
+                    std::cout << "Constant c for " << argv[i] << ": " << result.constantC << std::endl;
+                    std::cout << "Bad shares in " << argv[i] << ":";
+                    for (uint64_t x : result.badShares) std::cout << " " << x;
+                    std::cout << (result.badShares.empty() ? " none" : "") << std::endl;
+                    continue;
+                }
+                PolynomialSolver::ProcessResult result = PolynomialSolver::processTestCase(argv[i]);
+                std::cout << "Constant c for " << argv[i] << ": " << result.constantC << std::endl;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                status = 1;
+            }
+        }
+        PolynomialSolver::printStageCounters();
+        return status;
+    }
+    
     PolynomialSolver::runTests();
     
     return 0;